@@ -0,0 +1,16 @@
+#pragma once
+/*
+ * Timing helpers of the host benchmarks (test_benchmark() of the native tests)
+ */
+#include <stdint.h>
+#include <chrono>
+
+// wall clock time of f() in ms
+template <typename F>
+static double timeMs(F &&f) {
+  auto t0 = std::chrono::steady_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static volatile uint32_t sink; // benchmarks store results here so the measured code is not optimized away
@@ -0,0 +1,176 @@
+/*
+ * ApiRequest (api_request.h) against the String::indexOf()/strstr() lookups handleSet() used before
+ * every request of the corpus must give the same key presence and values with both parsers
+ */
+
+#include <unity.h>
+#include <string>
+#include "api_request.h"
+
+void setUp() {}
+void tearDown() {}
+
+// search string used by the old handleSet() for each key
+// keys without a trailing '=' were flags, matched anywhere in the request
+struct LegacyKey {
+  const char *needle;
+  ApiParam    param;
+};
+
+static const LegacyKey legacyKeys[] = {
+  {"&A=", API_A},   {"&B=", API_B},   {"B2=", API_B2},  {"C2=", API_C2},  {"C3=", API_C3},  {"CL=", API_CL},
+  {"CT=", API_CT},  {"FP=", API_FP},  {"FX=", API_FX},  {"FXD=", API_FXD},{"&G=", API_G},   {"G2=", API_G2},
+  {"GP=", API_GP},  {"H2", API_H2},   {"HU=", API_HU},  {"IN", API_IN},   {"IX=", API_IX},  {"&K=", API_K},
+  {"K2", API_K2},   {"LO=", API_LO},  {"LX=", API_LX},  {"LY=", API_LY},  {"&M=", API_M},   {"M1=", API_M1},
+  {"M2=", API_M2},  {"M3=", API_M3},  {"MI=", API_MI},  {"&ND", API_ND},  {"NF=", API_NF},  {"NL=", API_NL},
+  {"NM=", API_NM},  {"&NN", API_NN},  {"NP", API_NP},   {"NT=", API_NT},  {"OL=", API_OL},  {"P1=", API_P1},
+  {"P2=", API_P2},  {"PL=", API_PL},  {"PS=", API_PS},  {"&R=", API_R},   {"R2=", API_R2},  {"RB", API_RB},
+  {"RD=", API_RD},  {"RN=", API_RN},  {"RV=", API_RV},  {"&S=", API_S},   {"S2=", API_S2},  {"SA=", API_SA},
+  {"SB=", API_SB},  {"SC", API_SC},   {"SM=", API_SM},  {"SN=", API_SN},  {"SP=", API_SP},  {"SR", API_SR},
+  {"SS=", API_SS},  {"ST=", API_ST},  {"SV=", API_SV},  {"SW=", API_SW},  {"SX=", API_SX},  {"&T=", API_T},
+  {"TT=", API_TT},  {"U0=", API_U0},  {"U1=", API_U1},  {"&W=", API_W},   {"W2=", API_W2},  {"X1=", API_X1},
+  {"X2=", API_X2},  {"X3=", API_X3},
+};
+
+// requests as sent by the UI, integrations (Home Assistant, Hyperion, IR/button macros) and users
+static const char *corpus[] = {
+  "win",
+  "win&",
+  "win&T=2",
+  "win&T=0&A=0",
+  "win&A=128",
+  "win&A=~10",
+  "win&A=~-10&T=1",
+  "win&A=5&A=7",
+  "win&A&FX=5",
+  "win&A=&SX=20",
+  "win&&A=5",
+  "win&FX=~&SX=r",
+  "win&FX=12&FXD=&SX=128&IX=128&FP=5",
+  "win&FX=r&FP=r",
+  "win&X1=1&X2=2&X3=31&M1=1&M2=0&M3=1",
+  "win&SM=1&SS=2&SV=2&S=0&S2=30&GP=1&SP=0&RV=1&MI=0&SB=255&SW=1",
+  "win&SS=0&SV=0&S=10&S2=20&RV=0&MI=1&SW=2",
+  "win&HU=200&SA=255&H2",
+  "win&HU=65535&H2&SA=10",
+  "win&HU=100",
+  "win&K=3000&K2",
+  "win&K=6500",
+  "win&CL=hFF0000&C2=h00FF00&C3=0",
+  "win&CL=16711680",
+  "win&R=255&G=0&B=0&W=0&R2=1&G2=2&B2=3&W2=4",
+  "win&R=~10&G=~-10&B=r",
+  "win&LX=100100100&LY=200200200",
+  "win&SR=1",
+  "win&SR=0",
+  "win&SR",
+  "win&SC",
+  "win&SC&A=5",
+  "win&ND&NL=10&NT=0&NF=1",
+  "win&NL=0",
+  "win&NL=60&NF=2&NT=128",
+  "win&NN&A=~10",
+  "win&IN&A=5",
+  "win&A=5&IN",
+  "win&RB",
+  "win&NP",
+  "win&PL=~&P1=1&P2=5",
+  "win&PL=3",
+  "win&PS=3",
+  "win&OL=1",
+  "win&U0=5&U1=-6",
+  "win&TT=500",
+  "win&ST=1672531200",
+  "win&RN=1&RD=0",
+  "win&LO=1",
+  "win&LO=0",
+  "win&NM=1",
+  "win&CT=300",
+  "win&SN=1",
+  "win&M=1",
+  "win&B=128&B2=64",
+  "win&T=2&",
+  "win&T=2&&&",
+  "win&FX=9&SX=~-5&IX=~5&SB=~",
+  "win&SM=0&SS=0&SV=2&S=0&S2=288&GP=1&SP=0&RV=0&MI=0&SB=255&SW=1&CL=hFFAA00&C2=h000000&C3=h000000&FX=0&SX=128&IX=128&FP=0&A=255",
+};
+
+// value of a key: everything up to the next '&' (or end of request)
+static std::string valueAt(const char *v) {
+  const char *e = strchr(v, '&');
+  return e ? std::string(v, e - v) : std::string(v);
+}
+
+static void compareRequest(const char *req) {
+  const std::string s(req);
+  const ApiRequest api(req);
+  char msg[128];
+  for (const LegacyKey &k : legacyKeys) {
+    snprintf(msg, sizeof(msg), "request \"%s\" key \"%s\"", req, k.needle);
+    const size_t pos = s.find(k.needle);
+    const bool   old = pos != std::string::npos && pos > 0; // req.indexOf() > 0
+    const size_t len = strlen(k.needle);
+    if (k.needle[len-1] == '=') {
+      TEST_ASSERT_EQUAL_MESSAGE(old, api.has(k.param), msg);
+      if (old) {
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(valueAt(req + pos + len).c_str(), valueAt(api.value(k.param)).c_str(), msg);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(atol(req + pos + len), api.num(k.param), msg); // getNumVal()
+      }
+    } else {
+      TEST_ASSERT_EQUAL_MESSAGE(old, api.present(k.param), msg);
+    }
+  }
+  // "SR" was read with getNumVal() from 3 characters after the key, i.e. 0 unless given as "SR=<n>"
+  const size_t sr = s.find("SR");
+  if (sr != std::string::npos && sr > 0) {
+    const int old = atol(req + sr + 3);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(old, api.has(API_SR) ? api.num(API_SR) : 0, req);
+  }
+}
+
+static void test_corpus_matches_legacy_parser() {
+  for (const char *req : corpus) compareRequest(req);
+}
+
+static void test_key_without_value_has_no_value() {
+  const ApiRequest api("win&A&FX&SR&ND&T=1");
+  TEST_ASSERT_FALSE(api.has(API_A));
+  TEST_ASSERT_FALSE(api.has(API_FX));
+  TEST_ASSERT_FALSE(api.has(API_SR));
+  TEST_ASSERT_TRUE(api.present(API_A));
+  TEST_ASSERT_TRUE(api.present(API_SR));
+  TEST_ASSERT_TRUE(api.present(API_ND));
+  TEST_ASSERT_TRUE(api.has(API_T));
+  TEST_ASSERT_EQUAL_INT(1, api.num(API_T));
+}
+
+static void test_first_value_wins() {
+  const ApiRequest api("win&A&A=7&A=9");
+  TEST_ASSERT_TRUE(api.has(API_A));
+  TEST_ASSERT_EQUAL_INT(7, api.num(API_A));
+}
+
+static void test_unknown_and_long_keys_are_ignored() {
+  const ApiRequest api("win&ABCDE=1&ZZ=2&FXDX=3&SX=4");
+  TEST_ASSERT_FALSE(api.present(API_A));
+  TEST_ASSERT_FALSE(api.present(API_FXD));
+  TEST_ASSERT_TRUE(api.has(API_SX));
+  TEST_ASSERT_EQUAL_INT(4, api.num(API_SX));
+}
+
+static void test_flag_values() {
+  const ApiRequest api("win&RV=0&MI=1&LO=2");
+  TEST_ASSERT_FALSE(api.flag(API_RV));
+  TEST_ASSERT_TRUE(api.flag(API_MI));
+  TEST_ASSERT_TRUE(api.flag(API_LO));
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_corpus_matches_legacy_parser);
+  RUN_TEST(test_key_without_value_has_no_value);
+  RUN_TEST(test_first_value_wins);
+  RUN_TEST(test_unknown_and_long_keys_are_ignored);
+  RUN_TEST(test_flag_values);
+  return UNITY_END();
+}
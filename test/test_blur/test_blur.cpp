@@ -0,0 +1,145 @@
+/*
+ * Raw pixel buffer blur (blurPixelLine(), blurPixelRows(), blurPixelColumns()) against the per pixel algorithm
+ * Segment::blur()/Segment::blur2D() used before, results must be bit exact for random sizes and amounts
+ * timings of both are printed with pio test -e native -v
+ * note: the particle system blur2D() (FXparticleSystem.cpp) is not covered, it keeps its own additive math that ignores white
+ */
+
+#include <unity.h>
+#include "bench.h"
+#include <stdio.h>
+#include <vector>
+#include "color_math.h"
+
+void setUp() {}
+void tearDown() {}
+
+// previous Segment::blur2D(), with get/setPixelColorRaw() replaced by buffer access
+// color_fade() and color_add() are called across translation units like on the device
+// the old code skipped writing a pixel if it did not change, which compared against the original instead of the
+// already written first pixel (and could keep it unblurred), the kernels always write: compare with skipUnchanged = false
+template <bool skipUnchanged>
+static void oldBlur2D(uint32_t *pixels, unsigned cols, unsigned rows, uint8_t blur_x, uint8_t blur_y, bool smear) {
+  const auto XY = [&](unsigned x, unsigned y){ return x + y*cols; };
+  uint32_t lastnew = 0;
+  uint32_t last = 0;
+  if (blur_x) {
+    const uint8_t keepx = smear ? 255 : 255 - blur_x;
+    const uint8_t seepx = blur_x >> 1;
+    for (unsigned row = 0; row < rows; row++) { // blur rows (x direction)
+      uint32_t carryover = 0;
+      uint32_t curnew = 0;
+      for (unsigned x = 0; x < cols; x++) {
+        uint32_t cur = pixels[XY(x, row)];
+        uint32_t part = color_fade(cur, seepx);
+        curnew = color_fade(cur, keepx);
+        if (x > 0) {
+          if (carryover) curnew = color_add(curnew, carryover);
+          uint32_t prev = color_add(lastnew, part);
+          if (!skipUnchanged || last != prev) pixels[XY(x - 1, row)] = prev;
+        } else pixels[XY(x, row)] = curnew; // first pixel
+        lastnew = curnew;
+        last = cur;
+        carryover = part;
+      }
+      pixels[XY(cols-1, row)] = curnew; // set last pixel
+    }
+  }
+  if (blur_y) {
+    const uint8_t keepy = smear ? 255 : 255 - blur_y;
+    const uint8_t seepy = blur_y >> 1;
+    for (unsigned col = 0; col < cols; col++) {
+      uint32_t carryover = 0;
+      uint32_t curnew = 0;
+      for (unsigned y = 0; y < rows; y++) {
+        uint32_t cur = pixels[XY(col, y)];
+        uint32_t part = color_fade(cur, seepy);
+        curnew = color_fade(cur, keepy);
+        if (y > 0) {
+          if (carryover) curnew = color_add(curnew, carryover);
+          uint32_t prev = color_add(lastnew, part);
+          if (!skipUnchanged || last != prev) pixels[XY(col, y - 1)] = prev;
+        } else pixels[XY(col, y)] = curnew; // first pixel
+        lastnew = curnew;
+        last = cur;
+        carryover = part;
+      }
+      pixels[XY(col, rows - 1)] = curnew;
+    }
+  }
+}
+
+static uint32_t seed = 42;
+static uint32_t rnd() { seed = seed * 1664525 + 1013904223; return seed ^ (seed >> 13); }
+
+static std::vector<uint32_t> randomPixels(unsigned n) {
+  std::vector<uint32_t> c(n);
+  for (unsigned i = 0; i < n; i++) {
+    uint32_t r = rnd();
+    c[i] = (r & 0x300) ? r : 0; // some black pixels so the carryover check is exercised
+  }
+  return c;
+}
+
+// same as the new Segment::blur2D()
+static void newBlur2D(uint32_t *pixels, unsigned cols, unsigned rows, uint8_t blur_x, uint8_t blur_y, bool smear) {
+  if (blur_x) blurPixelRows(pixels, cols, rows, blur_x, smear);
+  if (blur_y) blurPixelColumns(pixels, cols, rows, blur_y, smear);
+}
+
+static void test_blur2D_matches_per_pixel_blur() {
+  char msg[96];
+  for (unsigned n = 0; n < 2000; n++) {
+    const unsigned cols = 1 + rnd() % 70; // covers partial column blocks
+    const unsigned rows = 1 + rnd() % 70;
+    const uint8_t bx = (n & 3) == 1 ? 0 : rnd();
+    const uint8_t by = (n & 3) == 2 ? 0 : rnd();
+    const bool smear = n & 4;
+    std::vector<uint32_t> ref = randomPixels(cols * rows);
+    std::vector<uint32_t> buf = ref;
+    oldBlur2D<false>(ref.data(), cols, rows, bx, by, smear);
+    newBlur2D(buf.data(), cols, rows, bx, by, smear);
+    snprintf(msg, sizeof(msg), "%ux%u blur %u/%u smear %d", cols, rows, bx, by, smear);
+    TEST_ASSERT_EQUAL_UINT32_ARRAY_MESSAGE(ref.data(), buf.data(), cols * rows, msg);
+  }
+}
+
+static void test_blurPixelLine_matches_per_pixel_blur() {
+  for (unsigned n = 0; n < 2000; n++) {
+    const unsigned len = 1 + rnd() % 300;
+    const uint8_t blur = rnd();
+    const bool smear = n & 1;
+    std::vector<uint32_t> ref = randomPixels(len);
+    std::vector<uint32_t> buf = ref;
+    oldBlur2D<false>(ref.data(), len, 1, blur, 0, smear); // previous Segment::blur() is the same as one row
+    blurPixelLine(buf.data(), len, blur, smear);
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(ref.data(), buf.data(), len);
+  }
+}
+
+static void test_benchmark() {
+  char msg[160];
+  constexpr unsigned ROUNDS = 500;
+  const unsigned sizes[][2] = {{16, 16}, {32, 32}, {128, 128}};
+  for (const auto &s : sizes) {
+    const unsigned cols = s[0], rows = s[1];
+    const unsigned rounds = ROUNDS * (128 * 128) / (cols * rows);
+    const std::vector<uint32_t> src = randomPixels(cols * rows);
+    std::vector<uint32_t> buf = src;
+    double tOld = timeMs([&] { for (unsigned r = 0; r < rounds; r++) { buf[r % buf.size()] |= 0x00404040; oldBlur2D<true>(buf.data(), cols, rows, 64, 64, false); } });
+    sink = buf[0];
+    buf = src;
+    double tNew = timeMs([&] { for (unsigned r = 0; r < rounds; r++) { buf[r % buf.size()] |= 0x00404040; newBlur2D(buf.data(), cols, rows, 64, 64, false); } });
+    sink = buf[0];
+    snprintf(msg, sizeof(msg), "blur2D %ux%u x %u: per pixel %.1f ms, blurPixelRows()/Columns() %.1f ms", cols, rows, rounds, tOld, tNew);
+    TEST_MESSAGE(msg);
+  }
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_blur2D_matches_per_pixel_blur);
+  RUN_TEST(test_blurPixelLine_matches_per_pixel_blur);
+  RUN_TEST(test_benchmark);
+  return UNITY_END();
+}
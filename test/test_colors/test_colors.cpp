@@ -0,0 +1,110 @@
+/*
+ * Raw pixel buffer functions (fadePixels(), blendPixels(), addPixels()) against the single pixel functions they replace
+ * results must be bit exact for all amounts, timings of both are printed with pio test -e native -v
+ */
+
+#include <unity.h>
+#include "bench.h"
+#include <stdio.h>
+#include <vector>
+#include "color_math.h"
+
+void setUp() {}
+void tearDown() {}
+
+static constexpr unsigned NUM_PIXELS = 4096;
+
+// pseudo random colors, the first ones are corner cases (black, single channels, full white, ...)
+static std::vector<uint32_t> testColors() {
+  static const uint32_t corner[] = {
+    0x00000000, 0xFFFFFFFF, 0x00FFFFFF, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x01010101,
+    0x80808080, 0x7F7F7F7F, 0x00010000, 0x00000100, 0x00000001, 0x01000000, 0xFE01FE01, 0x01FE01FE,
+  };
+  std::vector<uint32_t> c(NUM_PIXELS);
+  uint32_t seed = 42;
+  for (unsigned i = 0; i < NUM_PIXELS; i++) {
+    seed = seed * 1664525 + 1013904223;
+    c[i] = i < sizeof(corner)/sizeof(corner[0]) ? corner[i] : seed ^ (seed >> 13);
+  }
+  return c;
+}
+
+static void test_fadePixels_matches_color_fade() {
+  const std::vector<uint32_t> src = testColors();
+  std::vector<uint32_t> buf(NUM_PIXELS);
+  for (unsigned video = 0; video < 2; video++) {
+    for (unsigned amount = 0; amount < 256; amount++) {
+      buf = src;
+      fadePixels(buf.data(), NUM_PIXELS, amount, video);
+      for (unsigned i = 0; i < NUM_PIXELS; i++)
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(color_fade(src[i], amount, video), buf[i], video ? "video fade" : "fade");
+    }
+  }
+}
+
+static void test_blendPixels_matches_color_blend() {
+  const std::vector<uint32_t> src = testColors();
+  std::vector<uint32_t> other(src.rbegin(), src.rend());
+  std::vector<uint32_t> buf(NUM_PIXELS);
+  for (unsigned blend = 0; blend < 256; blend++) {
+    const uint32_t color = other[blend * 7];
+    buf = src;
+    blendPixels(buf.data(), NUM_PIXELS, color, blend);
+    for (unsigned i = 0; i < NUM_PIXELS; i++)
+      TEST_ASSERT_EQUAL_UINT32_MESSAGE(color_blend(src[i], color, blend), buf[i], "blend towards color");
+    buf = src;
+    blendPixels(buf.data(), other.data(), NUM_PIXELS, blend);
+    for (unsigned i = 0; i < NUM_PIXELS; i++)
+      TEST_ASSERT_EQUAL_UINT32_MESSAGE(color_blend(src[i], other[i], blend), buf[i], "blend buffers");
+  }
+}
+
+static void test_addPixels_matches_color_add() {
+  const std::vector<uint32_t> src = testColors();
+  std::vector<uint32_t> buf(NUM_PIXELS);
+  for (unsigned preserveCR = 0; preserveCR < 2; preserveCR++) {
+    for (unsigned k = 0; k < 512; k++) {
+      const uint32_t color = src[(k * 13) % NUM_PIXELS];
+      buf = src;
+      addPixels(buf.data(), NUM_PIXELS, color, preserveCR);
+      for (unsigned i = 0; i < NUM_PIXELS; i++)
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(color_add(src[i], color, preserveCR), buf[i], preserveCR ? "add preserving ratio" : "add");
+    }
+  }
+}
+
+static void test_benchmark() {
+  const std::vector<uint32_t> src = testColors();
+  std::vector<uint32_t> buf = src;
+  constexpr unsigned ROUNDS = 2000;
+  char msg[160];
+
+  double tScalar = timeMs([&] { for (unsigned r = 0; r < ROUNDS; r++) for (unsigned i = 0; i < NUM_PIXELS; i++) buf[i] = color_fade(buf[i] | 0x10101010, 200, true); });
+  double tArray  = timeMs([&] { for (unsigned r = 0; r < ROUNDS; r++) { buf[r & 1023] |= 0x10101010; fadePixels(buf.data(), NUM_PIXELS, 200, true); } });
+  sink = buf[0];
+  snprintf(msg, sizeof(msg), "fade (video), %u pixels x %u: color_fade() %.1f ms, fadePixels() %.1f ms", NUM_PIXELS, ROUNDS, tScalar, tArray);
+  TEST_MESSAGE(msg);
+
+  buf = src;
+  tScalar = timeMs([&] { for (unsigned r = 0; r < ROUNDS; r++) for (unsigned i = 0; i < NUM_PIXELS; i++) buf[i] = color_blend(buf[i], 0x00FF8000 + r, 100); });
+  tArray  = timeMs([&] { for (unsigned r = 0; r < ROUNDS; r++) blendPixels(buf.data(), NUM_PIXELS, 0x00FF8000 + r, 100); });
+  sink = buf[0];
+  snprintf(msg, sizeof(msg), "blend, %u pixels x %u: color_blend() %.1f ms, blendPixels() %.1f ms", NUM_PIXELS, ROUNDS, tScalar, tArray);
+  TEST_MESSAGE(msg);
+
+  buf = src;
+  tScalar = timeMs([&] { for (unsigned r = 0; r < ROUNDS; r++) for (unsigned i = 0; i < NUM_PIXELS; i++) buf[i] = color_add(buf[i] & 0x7F7F7F7F, 0x00402010 + r); });
+  tArray  = timeMs([&] { for (unsigned r = 0; r < ROUNDS; r++) { buf[r & 1023] &= 0x7F7F7F7F; addPixels(buf.data(), NUM_PIXELS, 0x00402010 + r); } });
+  sink = buf[0];
+  snprintf(msg, sizeof(msg), "add, %u pixels x %u: color_add() %.1f ms, addPixels() %.1f ms", NUM_PIXELS, ROUNDS, tScalar, tArray);
+  TEST_MESSAGE(msg);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_fadePixels_matches_color_fade);
+  RUN_TEST(test_blendPixels_matches_color_blend);
+  RUN_TEST(test_addPixels_matches_color_add);
+  RUN_TEST(test_benchmark);
+  return UNITY_END();
+}
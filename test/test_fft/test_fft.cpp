@@ -0,0 +1,148 @@
+/*
+ * Fixed point real-input FFT of the audioreactive usermod (computeRealFFT(), fftMajorPeak()) against a double precision
+ * DFT with the same processing as ArduinoFFT (dcRemoval(), Flat_top window, magnitudes)
+ * bin magnitudes must be within 1e-4 of the strongest bin (-80 dB), the major peak within 0.1 Hz
+ * timings of computeRealFFT() and a float complex FFT (like ArduinoFFT) are printed with pio test -e native -v
+ */
+
+#include <unity.h>
+#include "bench.h"
+#include <stdio.h>
+#include <complex>
+#include <utility>
+
+constexpr uint16_t samplesFFT = 512;
+constexpr uint16_t samplesFFT_2 = 256;
+constexpr float SAMPLE_RATE = 22050;
+#include "../../usermods/audioreactive/audio_fft.h"
+
+void setUp() {}
+void tearDown() {}
+
+static uint32_t seed = 1;
+static uint32_t rnd() { seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5; return seed; }
+
+static double flatTop(int i) {
+  double ratio = double(i) / double(samplesFFT - 1);
+  return 0.2810639 - 0.5208972 * cos(2.0 * M_PI * ratio) + 0.1980399 * cos(4.0 * M_PI * ratio);
+}
+
+// magnitudes of bins 0..samplesFFT-1, mirrored like computeRealFFT() output
+static void referenceDFT(const float *in, float *out) {
+  double mean = 0;
+  for (int i = 0; i < samplesFFT; i++) mean += in[i];
+  mean /= samplesFFT;
+  for (int k = 0; k <= samplesFFT_2; k++) {
+    std::complex<double> sum = 0;
+    for (int i = 0; i < samplesFFT; i++) sum += (in[i] - mean) * flatTop(i) * std::polar(1.0, -2.0 * M_PI * double(k) * i / samplesFFT);
+    out[k] = std::abs(sum);
+  }
+  for (int k = 1; k < samplesFFT_2; k++) out[samplesFFT - k] = out[k];
+}
+
+// two sines, noise and DC offset, amplitudes from 30 to 30000
+static void testSignal(float *in) {
+  const double amp = pow(10.0, (rnd() % 60) / 20.0) * 30.0;
+  const double f1 = (rnd() % 2200) / 10.0 + 1.0, f2 = (rnd() % 2000) / 10.0 + 0.5; // in bins
+  for (int i = 0; i < samplesFFT; i++)
+    in[i] = amp * sin(2.0 * M_PI * f1 * i / samplesFFT) + 0.3 * amp * sin(2.0 * M_PI * f2 * i / samplesFFT + 1.0)
+          + 0.05 * amp * (int(rnd() % 2001) - 1000) / 1000.0 + 100.0;
+}
+
+static void test_bins_match_reference() {
+  char msg[96];
+  float in[samplesFFT], bins[samplesFFT], ref[samplesFFT];
+  double worst = 0;
+  for (unsigned n = 0; n < 200; n++) {
+    testSignal(in);
+    memcpy(bins, in, sizeof(in));
+    computeRealFFT(bins);
+    referenceDFT(in, ref);
+    float maxRef = 0;
+    for (int k = 0; k <= samplesFFT_2; k++) maxRef = fmaxf(maxRef, ref[k]);
+    for (int k = 0; k < samplesFFT; k++) {
+      snprintf(msg, sizeof(msg), "signal %u bin %d", n, k);
+      TEST_ASSERT_FLOAT_WITHIN_MESSAGE(1e-4f * maxRef, ref[k], bins[k], msg);
+      worst = fmax(worst, fabs(bins[k] - ref[k]) / maxRef);
+    }
+  }
+  snprintf(msg, sizeof(msg), "max. error relative to strongest bin %.2e (%.1f dB)", worst, 20.0 * log10(worst));
+  TEST_MESSAGE(msg);
+}
+
+static void test_major_peak_matches_reference() {
+  char msg[96];
+  float in[samplesFFT], bins[samplesFFT], ref[samplesFFT];
+  for (unsigned n = 0; n < 200; n++) {
+    testSignal(in);
+    memcpy(bins, in, sizeof(in));
+    computeRealFFT(bins);
+    referenceDFT(in, ref);
+    float freq, value, refFreq, refValue;
+    fftMajorPeak(bins, SAMPLE_RATE, &freq, &value);
+    fftMajorPeak(ref, SAMPLE_RATE, &refFreq, &refValue);
+    snprintf(msg, sizeof(msg), "signal %u", n);
+    TEST_ASSERT_FLOAT_WITHIN_MESSAGE(0.1f, refFreq, freq, msg);
+    TEST_ASSERT_FLOAT_WITHIN_MESSAGE(1e-3f * refValue, refValue, value, msg);
+  }
+}
+
+static void test_silence() {
+  float bins[samplesFFT];
+  for (int i = 0; i < samplesFFT; i++) bins[i] = 1234.0f; // DC only
+  computeRealFFT(bins);
+  for (int k = 0; k < samplesFFT; k++) TEST_ASSERT_EQUAL_FLOAT(0.0f, bins[k]);
+  float freq = 1, value = 1;
+  fftMajorPeak(bins, SAMPLE_RATE, &freq, &value);
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, freq);
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, value);
+}
+
+// float complex radix-2 FFT doing the same steps as ArduinoFFT, for timing only
+static void floatFFT(const float *in, float *out) {
+  float re[samplesFFT], im[samplesFFT];
+  float mean = 0;
+  for (int i = 0; i < samplesFFT; i++) mean += in[i];
+  mean /= samplesFFT;
+  for (int i = 0; i < samplesFFT; i++) { re[i] = (in[i] - mean) * float(flatTop(i)); im[i] = 0; }
+  for (int i = 1, j = 0; i < samplesFFT; i++) {
+    int bit = samplesFFT_2;
+    for (; j & bit; bit >>= 1) j ^= bit;
+    j |= bit;
+    if (i < j) { std::swap(re[i], re[j]); std::swap(im[i], im[j]); }
+  }
+  for (int len = 2; len <= samplesFFT; len <<= 1) {
+    const float ang = -2.0f * float(M_PI) / len;
+    for (int i = 0; i < samplesFFT; i += len) {
+      for (int k = 0; k < len / 2; k++) {
+        const float wr = cosf(ang * k), wi = sinf(ang * k);
+        const int a = i + k, b = a + len / 2;
+        const float tr = re[b] * wr - im[b] * wi, ti = re[b] * wi + im[b] * wr;
+        re[b] = re[a] - tr; im[b] = im[a] - ti;
+        re[a] += tr;        im[a] += ti;
+      }
+    }
+  }
+  for (int i = 0; i < samplesFFT; i++) out[i] = sqrtf(re[i] * re[i] + im[i] * im[i]);
+}
+
+static void test_benchmark() {
+  constexpr unsigned ROUNDS = 20000;
+  char msg[128];
+  float in[samplesFFT], bins[samplesFFT];
+  testSignal(in);
+  double tFixed = timeMs([&] { for (unsigned r = 0; r < ROUNDS; r++) { memcpy(bins, in, sizeof(in)); computeRealFFT(bins); sink = uint32_t(bins[r % samplesFFT]); } });
+  double tFloat = timeMs([&] { for (unsigned r = 0; r < ROUNDS; r++) { floatFFT(in, bins); sink = uint32_t(bins[r % samplesFFT]); } });
+  snprintf(msg, sizeof(msg), "%u samples x %u: computeRealFFT() %.1f ms, float complex FFT %.1f ms", samplesFFT, ROUNDS, tFixed, tFloat);
+  TEST_MESSAGE(msg);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  if (!allocRealFFT()) return 1;
+  RUN_TEST(test_bins_match_reference);
+  RUN_TEST(test_major_peak_matches_reference);
+  RUN_TEST(test_silence);
+  RUN_TEST(test_benchmark);
+  return UNITY_END();
+}
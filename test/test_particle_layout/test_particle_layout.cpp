@@ -0,0 +1,311 @@
+/*
+ * Host benchmark of the 2D particle move step (ParticleSystem2D::moveParticles()) with different loop and memory layouts
+ * this is a benchmark, not a correctness test of the particle system: the particle structs and the move function are
+ * hand copied replicas of FXparticleSystem.h/.cpp (wall roughness omitted, it uses the hardware RNG) and can drift from
+ * them, the particle system itself depends on wled.h and cannot be built on the host
+ * the variants are only checked against each other (identical particles), timings are printed with pio test -e native -v
+ * note: host numbers only show relative cost on a desktop CPU, they do not replace measurements on ESP32 (timing and flash)
+ */
+
+#include <unity.h>
+#include "bench.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+void setUp() {}
+void tearDown() {}
+
+#define PS_P_RADIUS 64
+#define PS_P_HALFRADIUS (PS_P_RADIUS >> 1)
+#define PS_P_MINHARDRADIUS 64
+
+typedef struct { // 10 bytes
+  int16_t x;
+  int16_t y;
+  uint16_t ttl;
+  int8_t vx;
+  int8_t vy;
+  uint8_t hue;
+  uint8_t sat;
+} PSparticle;
+
+typedef union {
+  struct {
+    bool outofbounds : 1;
+    bool collide : 1;
+    bool perpetual : 1;
+    bool custom : 5;
+  };
+  uint8_t asByte;
+} PSparticleFlags;
+
+typedef struct {
+  uint8_t size;
+  uint8_t forcecounter;
+} PSadvancedParticle;
+
+typedef union {
+  struct {
+    bool wrapX : 1;
+    bool wrapY : 1;
+    bool bounceX : 1;
+    bool bounceY : 1;
+    bool killoutofbounds : 1;
+    bool useGravity : 1;
+    bool useCollisions : 1;
+    bool colorByAge : 1;
+  };
+  uint8_t asByte;
+} PSsettings2D;
+
+// structure of arrays layout of the same particle data
+struct PSparticlesSoA {
+  std::vector<int16_t>  x, y;
+  std::vector<uint16_t> ttl;
+  std::vector<int8_t>   vx, vy;
+  std::vector<uint8_t>  hue, sat, flags;
+  explicit PSparticlesSoA(size_t n) : x(n), y(n), ttl(n), vx(n), vy(n), hue(n), sat(n), flags(n) {}
+};
+
+static bool checkBoundsAndWrap(int32_t &position, const int32_t max, const int32_t particleradius, const bool wrap) {
+  if ((uint32_t)position > (uint32_t)max) {
+    if (wrap) {
+      position = position % (max + 1);
+      if (position < 0)
+        position += max + 1;
+    }
+    else if (((position < -particleradius) || (position > max + particleradius)))
+      return false;
+  }
+  return true;
+}
+
+struct MoveBench {
+  int32_t  maxX, maxY;
+  uint32_t particleHardRadius;
+  uint8_t  particlesize;
+  uint8_t  wallHardness;
+  PSsettings2D particlesettings;
+
+  void setParticleSize(uint8_t size) {
+    particlesize = size;
+    particleHardRadius = PS_P_MINHARDRADIUS;
+    if (particlesize > 1) particleHardRadius = particleHardRadius > particlesize ? particleHardRadius : particlesize;
+    else if (particlesize == 0) particleHardRadius >>= 1;
+  }
+
+  void bounce(int8_t &incomingspeed, int32_t &position, const uint32_t maxposition) {
+    incomingspeed = -incomingspeed;
+    incomingspeed = (incomingspeed * wallHardness + 128) >> 8;
+    if (position < (int32_t)particleHardRadius) position = particleHardRadius;
+    else position = maxposition - particleHardRadius;
+  }
+
+  // same as ParticleSystem2D::moveParticle()
+  template <typename Settings>
+  inline __attribute__((always_inline)) void move(PSparticle &part, PSparticleFlags &partFlags, const Settings &options, PSadvancedParticle *advancedproperties) {
+    if (part.ttl > 0) {
+      if (!partFlags.perpetual) part.ttl--;
+      if (options.colorByAge) part.hue = part.ttl < 255 ? part.ttl : 255;
+      int32_t renderradius = PS_P_HALFRADIUS;
+      int32_t newX = part.x + (int32_t)part.vx;
+      int32_t newY = part.y + (int32_t)part.vy;
+      partFlags.outofbounds = false;
+      if (advancedproperties) {
+        setParticleSize(particlesize);
+        if (advancedproperties->size > PS_P_MINHARDRADIUS) {
+          particleHardRadius += (advancedproperties->size - PS_P_MINHARDRADIUS);
+          renderradius = particleHardRadius;
+        }
+      }
+      if (options.bounceY) {
+        if ((newY < (int32_t)particleHardRadius) || ((newY > (int32_t)(maxY - particleHardRadius)) && !options.useGravity))
+          bounce(part.vy, newY, maxY);
+      }
+      if (!checkBoundsAndWrap(newY, maxY, renderradius, options.wrapY)) {
+        partFlags.outofbounds = true;
+        if (options.killoutofbounds) {
+          if (newY < 0) part.ttl = 0;
+          else if (!options.useGravity) part.ttl = 0;
+        }
+      }
+      if (part.ttl) {
+        if (options.bounceX) {
+          if ((newX < (int32_t)particleHardRadius) || (newX > (int32_t)(maxX - particleHardRadius)))
+            bounce(part.vx, newX, maxX);
+        }
+        else if (!checkBoundsAndWrap(newX, maxX, renderradius, options.wrapX)) {
+          partFlags.outofbounds = true;
+          if (options.killoutofbounds) part.ttl = 0;
+        }
+      }
+      part.x = (int16_t)newX;
+      part.y = (int16_t)newY;
+    }
+  }
+
+  // before batching: particleMoveUpdate() per particle, settings read through a pointer
+  __attribute__((noinline)) void moveOne(PSparticle &part, PSparticleFlags &partFlags, PSsettings2D *options, PSadvancedParticle *adv) {
+    if (options == nullptr) options = &particlesettings;
+    move(part, partFlags, *options, adv);
+  }
+  void movePerCall(PSparticle *p, PSparticleFlags *f, PSadvancedParticle *adv, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) moveOne(p[i], f[i], nullptr, adv ? &adv[i] : nullptr);
+  }
+
+  // current moveParticles(): one loop, local copy of the settings
+  void moveSingleLoop(PSparticle *p, PSparticleFlags *f, PSadvancedParticle *adv, uint32_t n) {
+    const PSsettings2D options = particlesettings;
+    for (uint32_t i = 0; i < n; i++) move(p[i], f[i], options, adv ? &adv[i] : nullptr);
+  }
+
+  // one loop per advanced properties case
+  void moveTwoLoops(PSparticle *p, PSparticleFlags *f, PSadvancedParticle *adv, uint32_t n) {
+    const PSsettings2D options = particlesettings;
+    if (adv) { for (uint32_t i = 0; i < n; i++) move(p[i], f[i], options, &adv[i]); }
+    else     { for (uint32_t i = 0; i < n; i++) move(p[i], f[i], options, nullptr); }
+  }
+
+  // structure of arrays, no advanced properties
+  void moveSoA(PSparticlesSoA &s, uint32_t n) {
+    const PSsettings2D options = particlesettings;
+    for (uint32_t i = 0; i < n; i++) {
+      if (s.ttl[i] == 0) continue;
+      PSparticleFlags flags; flags.asByte = s.flags[i];
+      if (!flags.perpetual) s.ttl[i]--;
+      if (options.colorByAge) s.hue[i] = s.ttl[i] < 255 ? s.ttl[i] : 255;
+      int32_t newX = s.x[i] + (int32_t)s.vx[i];
+      int32_t newY = s.y[i] + (int32_t)s.vy[i];
+      flags.outofbounds = false;
+      if (options.bounceY) {
+        if ((newY < (int32_t)particleHardRadius) || ((newY > (int32_t)(maxY - particleHardRadius)) && !options.useGravity))
+          bounce(s.vy[i], newY, maxY);
+      }
+      if (!checkBoundsAndWrap(newY, maxY, PS_P_HALFRADIUS, options.wrapY)) {
+        flags.outofbounds = true;
+        if (options.killoutofbounds) {
+          if (newY < 0) s.ttl[i] = 0;
+          else if (!options.useGravity) s.ttl[i] = 0;
+        }
+      }
+      if (s.ttl[i]) {
+        if (options.bounceX) {
+          if ((newX < (int32_t)particleHardRadius) || (newX > (int32_t)(maxX - particleHardRadius)))
+            bounce(s.vx[i], newX, maxX);
+        }
+        else if (!checkBoundsAndWrap(newX, maxX, PS_P_HALFRADIUS, options.wrapX)) {
+          flags.outofbounds = true;
+          if (options.killoutofbounds) s.ttl[i] = 0;
+        }
+      }
+      s.x[i] = (int16_t)newX;
+      s.y[i] = (int16_t)newY;
+      s.flags[i] = flags.asByte;
+    }
+  }
+};
+
+static constexpr uint32_t NUM_PARTICLES = 4096; // e.g. 64x64 matrix, one particle per pixel
+static constexpr unsigned FRAMES = 2000;
+
+struct ParticleSet {
+  std::vector<PSparticle> p;
+  std::vector<PSparticleFlags> f;
+  std::vector<PSadvancedParticle> adv;
+  ParticleSet() : p(NUM_PARTICLES), f(NUM_PARTICLES), adv(NUM_PARTICLES) {
+    uint32_t seed = 1;
+    auto rnd = [&seed](uint32_t n) { seed = seed * 1103515245 + 12345; return (seed >> 16) % n; };
+    for (uint32_t i = 0; i < NUM_PARTICLES; i++) {
+      p[i].x = rnd(64 * PS_P_RADIUS);
+      p[i].y = rnd(64 * PS_P_RADIUS);
+      p[i].ttl = 500 + rnd(3000);
+      p[i].vx = int(rnd(200)) - 100;
+      p[i].vy = int(rnd(200)) - 100;
+      p[i].hue = rnd(256);
+      p[i].sat = 255;
+      f[i].asByte = 0;
+      f[i].perpetual = (i & 7) == 0;
+      adv[i].size = rnd(256);
+      adv[i].forcecounter = 0;
+    }
+  }
+};
+
+static MoveBench makeBench(uint8_t settings) {
+  MoveBench b;
+  b.maxX = 64 * PS_P_RADIUS - 1;
+  b.maxY = 64 * PS_P_RADIUS - 1;
+  b.wallHardness = 200;
+  b.particlesettings.asByte = settings;
+  b.setParticleSize(1);
+  return b;
+}
+
+static void assertSame(const ParticleSet &a, const ParticleSet &b, const char *what) {
+  for (uint32_t i = 0; i < NUM_PARTICLES; i++) {
+    TEST_ASSERT_TRUE_MESSAGE(memcmp(&a.p[i], &b.p[i], sizeof(PSparticle)) == 0 && a.f[i].asByte == b.f[i].asByte, what);
+  }
+}
+
+static void runLayouts(uint8_t settings, bool advanced, const char *name) {
+  MoveBench b1 = makeBench(settings), b2 = b1, b3 = b1, b4 = b1;
+  ParticleSet perCall, single, two;
+  PSparticlesSoA soa(NUM_PARTICLES);
+  for (uint32_t i = 0; i < NUM_PARTICLES; i++) {
+    soa.x[i] = perCall.p[i].x; soa.y[i] = perCall.p[i].y; soa.ttl[i] = perCall.p[i].ttl;
+    soa.vx[i] = perCall.p[i].vx; soa.vy[i] = perCall.p[i].vy; soa.hue[i] = perCall.p[i].hue;
+    soa.sat[i] = perCall.p[i].sat; soa.flags[i] = perCall.f[i].asByte;
+  }
+  PSadvancedParticle *adv1 = advanced ? perCall.adv.data() : nullptr;
+  PSadvancedParticle *adv2 = advanced ? single.adv.data() : nullptr;
+  PSadvancedParticle *adv3 = advanced ? two.adv.data() : nullptr;
+
+  double tPerCall = timeMs([&] { for (unsigned k = 0; k < FRAMES; k++) b1.movePerCall(perCall.p.data(), perCall.f.data(), adv1, NUM_PARTICLES); });
+  double tSingle  = timeMs([&] { for (unsigned k = 0; k < FRAMES; k++) b2.moveSingleLoop(single.p.data(), single.f.data(), adv2, NUM_PARTICLES); });
+  double tTwo     = timeMs([&] { for (unsigned k = 0; k < FRAMES; k++) b3.moveTwoLoops(two.p.data(), two.f.data(), adv3, NUM_PARTICLES); });
+  double tSoA     = advanced ? 0 : timeMs([&] { for (unsigned k = 0; k < FRAMES; k++) b4.moveSoA(soa, NUM_PARTICLES); });
+
+  assertSame(perCall, single, "single loop differs from per particle call");
+  assertSame(perCall, two, "two loops differ from per particle call");
+  if (!advanced) {
+    for (uint32_t i = 0; i < NUM_PARTICLES; i++) {
+      TEST_ASSERT_TRUE_MESSAGE(soa.x[i] == perCall.p[i].x && soa.y[i] == perCall.p[i].y && soa.ttl[i] == perCall.p[i].ttl
+                               && soa.vx[i] == perCall.p[i].vx && soa.vy[i] == perCall.p[i].vy && soa.hue[i] == perCall.p[i].hue
+                               && soa.flags[i] == perCall.f[i].asByte, "structure of arrays differs from per particle call");
+    }
+  }
+
+  char msg[200];
+  if (advanced)
+    snprintf(msg, sizeof(msg), "%s, %u particles x %u frames: per call %.1f ms, single loop %.1f ms, two loops %.1f ms",
+             name, (unsigned)NUM_PARTICLES, FRAMES, tPerCall, tSingle, tTwo);
+  else
+    snprintf(msg, sizeof(msg), "%s, %u particles x %u frames: per call %.1f ms, single loop %.1f ms, two loops %.1f ms, SoA %.1f ms",
+             name, (unsigned)NUM_PARTICLES, FRAMES, tPerCall, tSingle, tTwo, tSoA);
+  TEST_MESSAGE(msg);
+}
+
+static void test_move_bounce() {
+  PSsettings2D s; s.asByte = 0; s.bounceX = s.bounceY = s.colorByAge = true;
+  runLayouts(s.asByte, false, "bounce");
+}
+
+static void test_move_wrap_kill() {
+  PSsettings2D s; s.asByte = 0; s.wrapX = s.killoutofbounds = true;
+  runLayouts(s.asByte, false, "wrap X, kill out of bounds");
+}
+
+static void test_move_advanced() {
+  PSsettings2D s; s.asByte = 0; s.bounceX = s.bounceY = true;
+  runLayouts(s.asByte, true, "bounce, advanced size");
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_move_bounce);
+  RUN_TEST(test_move_wrap_kill);
+  RUN_TEST(test_move_advanced);
+  return UNITY_END();
+}
@@ -0,0 +1,110 @@
+/*
+ * Perlin noise line functions (perlin2D_rawLine(), perlin3D_rawLine(), perlin16Line(), perlin8Line()) against the single sample functions
+ * results must be identical for random start coordinates, positive and negative steps and coordinate wrap around (7.68M samples)
+ * timings of both are printed with pio test -e native -v
+ */
+
+#include <unity.h>
+#include "bench.h"
+#include <stdio.h>
+#include "wled_math.h"
+
+void setUp() {}
+void tearDown() {}
+
+static constexpr unsigned LINES = 20000;
+static constexpr unsigned LEN = 64;
+
+static uint32_t seed = 5;
+static uint32_t rnd() { seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5; return seed; }
+
+// random step, from very small (many samples per lattice cell) to very large (every sample in another cell)
+static int32_t rndStep() { return (int32_t)rnd() >> (8 + rnd() % 24); }
+
+static void test_perlin_raw_lines() {
+  char msg[128];
+  int32_t out[LEN];
+  for (unsigned k = 0; k < LINES; k++) {
+    const uint32_t x = rnd(), y = rnd(), z = rnd();
+    const int32_t sx = rndStep();
+    const int32_t sy = k % 4 == 0 ? 0 : rndStep(); // zero steps are the common case in effects
+    const int32_t sz = k % 3 == 0 ? 0 : rndStep();
+    const bool is16bit = k & 1;
+    snprintf(msg, sizeof(msg), "line %u: x %u y %u z %u step %d/%d/%d 16bit %d", k, x, y, z, sx, sy, sz, is16bit);
+    perlin2D_rawLine(out, LEN, x, y, sx, sy, is16bit);
+    for (unsigned i = 0; i < LEN; i++)
+      TEST_ASSERT_EQUAL_INT32_MESSAGE(perlin2D_raw(x + i*sx, y + i*sy, is16bit), out[i], msg);
+    perlin3D_rawLine(out, LEN, x, y, z, sx, sy, sz, is16bit);
+    for (unsigned i = 0; i < LEN; i++)
+      TEST_ASSERT_EQUAL_INT32_MESSAGE(perlin3D_raw(x + i*sx, y + i*sy, z + i*sz, is16bit), out[i], msg);
+  }
+}
+
+static void test_perlin16_lines() {
+  char msg[128];
+  uint16_t out[LEN];
+  for (unsigned k = 0; k < LINES; k++) {
+    const uint32_t x = rnd(), y = rnd(), z = rnd();
+    const int32_t sx = rndStep();
+    const int32_t sy = k % 4 == 0 ? 0 : rndStep();
+    const int32_t sz = k % 3 == 0 ? 0 : rndStep();
+    snprintf(msg, sizeof(msg), "line %u: x %u y %u z %u step %d/%d/%d", k, x, y, z, sx, sy, sz);
+    perlin16Line(out, LEN, x, y, sx, sy);
+    for (unsigned i = 0; i < LEN; i++)
+      TEST_ASSERT_EQUAL_UINT16_MESSAGE(perlin16(x + i*sx, y + i*sy), out[i], msg);
+    perlin16Line(out, LEN, x, y, z, sx, sy, sz);
+    for (unsigned i = 0; i < LEN; i++)
+      TEST_ASSERT_EQUAL_UINT16_MESSAGE(perlin16(x + i*sx, y + i*sy, z + i*sz), out[i], msg);
+  }
+}
+
+// perlin8() takes 16bit coordinates, the line has to wrap around like the callers' uint16_t arithmetic does
+static void test_perlin8_lines() {
+  char msg[128];
+  uint8_t out[LEN];
+  for (unsigned k = 0; k < LINES; k++) {
+    const uint16_t x = rnd(), y = rnd(), z = rnd();
+    const int sx = (int)(rnd() % 2000) - 1000;
+    const int sy = k % 4 == 0 ? 0 : (int)(rnd() % 2000) - 1000;
+    const int sz = k % 3 == 0 ? 0 : (int)(rnd() % 200) - 100;
+    snprintf(msg, sizeof(msg), "line %u: x %u y %u z %u step %d/%d/%d", k, x, y, z, sx, sy, sz);
+    perlin8Line(out, LEN, x, y, sx, sy);
+    for (unsigned i = 0; i < LEN; i++)
+      TEST_ASSERT_EQUAL_UINT8_MESSAGE(perlin8(uint16_t(x + i*sx), uint16_t(y + i*sy)), out[i], msg);
+    perlin8Line(out, LEN, x, y, z, sx, sy, sz);
+    for (unsigned i = 0; i < LEN; i++)
+      TEST_ASSERT_EQUAL_UINT8_MESSAGE(perlin8(uint16_t(x + i*sx), uint16_t(y + i*sy), uint16_t(z + i*sz)), out[i], msg);
+  }
+}
+
+// 64x64 frames with the steps used by typical effects
+static void test_benchmark() {
+  constexpr unsigned W = 64, H = 64, FRAMES = 200;
+  static uint8_t  g8[W * H];
+  static uint16_t g16[W * H];
+  char msg[160];
+
+  double tSingle = timeMs([&] { for (unsigned r = 0; r < FRAMES; r++) { for (unsigned y = 0; y < H; y++) for (unsigned x = 0; x < W; x++) g8[x + y*W] = perlin8(x*40, y*40, r*3); sink += g8[r]; } });
+  double tLine   = timeMs([&] { for (unsigned r = 0; r < FRAMES; r++) { for (unsigned y = 0; y < H; y++) perlin8Line(g8 + y*W, W, 0, y*40, r*3, 40, 0, 0); sink += g8[r]; } });
+  snprintf(msg, sizeof(msg), "perlin8 3D, %ux%u x %u: perlin8() %.1f ms, perlin8Line() %.1f ms", W, H, FRAMES, tSingle, tLine);
+  TEST_MESSAGE(msg);
+
+  tSingle = timeMs([&] { for (unsigned r = 0; r < FRAMES; r++) { for (unsigned y = 0; y < H; y++) for (unsigned x = 0; x < W; x++) g16[x + y*W] = perlin16(x*3000, y*3000 + r); sink += g16[r]; } });
+  tLine   = timeMs([&] { for (unsigned r = 0; r < FRAMES; r++) { for (unsigned y = 0; y < H; y++) perlin16Line(g16 + y*W, W, 0, y*3000 + r, 3000, 0); sink += g16[r]; } });
+  snprintf(msg, sizeof(msg), "perlin16 2D, %ux%u x %u: perlin16() %.1f ms, perlin16Line() %.1f ms", W, H, FRAMES, tSingle, tLine);
+  TEST_MESSAGE(msg);
+
+  tSingle = timeMs([&] { for (unsigned r = 0; r < FRAMES; r++) { for (unsigned y = 0; y < H; y++) for (unsigned x = 0; x < W; x++) g16[x + y*W] = perlin16(1000 + 2500*x, 7000 + 2500*y, r*100); sink += g16[r]; } });
+  tLine   = timeMs([&] { for (unsigned r = 0; r < FRAMES; r++) { for (unsigned y = 0; y < H; y++) perlin16Line(g16 + y*W, W, 1000, 7000 + 2500*y, r*100, 2500, 0, 0); sink += g16[r]; } });
+  snprintf(msg, sizeof(msg), "perlin16 3D, %ux%u x %u: perlin16() %.1f ms, perlin16Line() %.1f ms", W, H, FRAMES, tSingle, tLine);
+  TEST_MESSAGE(msg);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_perlin_raw_lines);
+  RUN_TEST(test_perlin16_lines);
+  RUN_TEST(test_perlin8_lines);
+  RUN_TEST(test_benchmark);
+  return UNITY_END();
+}
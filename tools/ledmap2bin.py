@@ -0,0 +1,42 @@
+#!/usr/bin/env python3
+"""
+Converts WLED ledmap JSON file (ledmapN.json) into binary ledmap (ledmapN.bin) which loads much faster.
+Upload the resulting file to WLED file system instead of (or next to, it takes precedence) the JSON file.
+
+usage: ledmap2bin.py ledmap1.json [ledmap1.bin]
+"""
+import json
+import struct
+import sys
+
+LEDMAP_BIN_MAGIC = 0x504D4C57  # "WLMP"
+LEDMAP_BIN_VERSION = 1
+MAX_ENTRIES = 65535
+
+
+def convert(src, dst):
+    with open(src, "r", encoding="utf-8") as f:
+        ledmap = json.load(f)
+
+    entries = ledmap.get("map", [])
+    if len(entries) > MAX_ENTRIES:
+        raise ValueError(f"too many entries ({len(entries)})")
+    # negative values (and values out of range, same as WLED's JSON parser) mark missing pixels
+    entries = [0xFFFF if (not isinstance(e, int) or e < 0 or e > 16384) else e for e in entries]
+
+    name = ledmap.get("n", "").encode("utf-8")[:32]
+    header = struct.pack("<IBBHHH32s", LEDMAP_BIN_MAGIC, LEDMAP_BIN_VERSION, 0,
+                         int(ledmap.get("width", 0)), int(ledmap.get("height", 0)), len(entries), name)
+    with open(dst, "wb") as f:
+        f.write(header)
+        f.write(struct.pack(f"<{len(entries)}H", *entries))
+    print(f"{dst}: {len(entries)} entries, {len(header) + 2 * len(entries)} bytes")
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+    src = sys.argv[1]
+    dst = sys.argv[2] if len(sys.argv) > 2 else (src[:-5] if src.endswith(".json") else src) + ".bin"
+    convert(src, dst)
@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""
+Converts an animated GIF, video or image sequence into a WLED video clip (.wvc) for the "Image" effect.
+Frames are scaled to the exact segment size, so the clip plays without decoding or scaling on the device.
+Upload the resulting file to WLED file system and use its name as the segment name.
+
+usage: video2wvc.py input width height [output.wvc] [--fps N]
+  input is an animated GIF/WebP/PNG, a directory of images (sorted by name) or, if imageio is installed, a video file.
+  --fps 0 plays the clip at the effect frame rate (as fast as possible).
+Requires Pillow (pip install pillow).
+"""
+import argparse
+import os
+import struct
+
+from PIL import Image, ImageSequence
+
+WVC_MAGIC = 0x4C435657  # "WVCL"
+WVC_VERSION = 1
+MAX_FILE_NAME = 32  # WLED segment name length
+
+
+def load_frames(src):
+    """yields (PIL image, delay in ms or None)"""
+    if os.path.isdir(src):
+        for name in sorted(os.listdir(src)):
+            try:
+                img = Image.open(os.path.join(src, name))
+            except OSError:
+                continue
+            yield img, None
+        return
+    try:
+        img = Image.open(src)
+        for frame in ImageSequence.Iterator(img):
+            yield frame.copy(), frame.info.get("duration")
+    except OSError:
+        import imageio.v3 as iio  # optional, for video files
+        for frame in iio.imiter(src):
+            yield Image.fromarray(frame), None
+
+
+def convert(src, dst, width, height, fps):
+    frames = []
+    delay = None
+    for img, duration in load_frames(src):
+        frames.append(img.convert("RGB").resize((width, height), Image.LANCZOS).tobytes())
+        if delay is None and duration:
+            delay = int(duration)
+    if not frames:
+        raise ValueError("no frames found")
+    if fps is not None:
+        delay = round(1000 / fps) if fps > 0 else 0  # 0: effect frame rate
+    elif delay is None:
+        delay = 50
+    delay = min(delay, 65535)
+    with open(dst, "wb") as f:
+        f.write(struct.pack("<IBBHHHI", WVC_MAGIC, WVC_VERSION, 0, width, height, delay, len(frames)))
+        for frame in frames:
+            f.write(frame)
+    size = os.path.getsize(dst)
+    print(f"{dst}: {width}x{height}, {len(frames)} frames, {delay} ms/frame, {size} bytes")
+    if len(os.path.basename(dst)) > MAX_FILE_NAME:
+        print(f"warning: file name is longer than {MAX_FILE_NAME} characters")
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input")
+    parser.add_argument("width", type=int)
+    parser.add_argument("height", type=int)
+    parser.add_argument("output", nargs="?")
+    parser.add_argument("--fps", type=float, help="frame rate (default: GIF frame delay or 20)")
+    args = parser.parse_args()
+    dst = args.output or os.path.splitext(args.input.rstrip("/"))[0] + ".wvc"
+    convert(args.input, dst, args.width, args.height, args.fps)
@@ -0,0 +1,106 @@
+#pragma once
+/*
+ * Fixed point real-input FFT used by the audioreactive usermod with UM_AUDIOREACTIVE_USE_INTEGER_FFT,
+ * much lighter than ArduinoFFT on MCUs without FPU (-S2, -C3).
+ * Only depends on the C library so it can be tested on the host (test/test_fft).
+ * samplesFFT and samplesFFT_2 (samplesFFT/2) have to be defined before including this file.
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// The samplesFFT real samples are packed into a complex FFT of half size (even samples -> real, odd samples -> imaginary),
+// which is then split into the spectrum of the real signal. Samples are scaled to a common exponent (block floating point)
+// so that results cannot overflow. Window and twiddle factors are precomputed (Q30).
+constexpr uint16_t samplesFFT_4 = samplesFFT_2 / 2;
+static int32_t *fftWindow = nullptr;            // "Flat Top" window, samplesFFT entries
+static int32_t *fftCos = nullptr;               // cos(2*pi*k/samplesFFT), k < samplesFFT_2
+static int32_t *fftSin = nullptr;               // sin(2*pi*k/samplesFFT), k < samplesFFT_2
+static int32_t *fftRe = nullptr;                // working buffers, samplesFFT_2 entries
+static int32_t *fftIm = nullptr;
+
+static inline int32_t mulQ30(int32_t a, int32_t b) { return (int64_t(a) * b) >> 30; }
+
+static bool allocRealFFT() {
+  if (!fftWindow) fftWindow = (int32_t*) calloc(sizeof(int32_t), samplesFFT);
+  if (!fftCos)    fftCos    = (int32_t*) calloc(sizeof(int32_t), samplesFFT_2);
+  if (!fftSin)    fftSin    = (int32_t*) calloc(sizeof(int32_t), samplesFFT_2);
+  if (!fftRe)     fftRe     = (int32_t*) calloc(sizeof(int32_t), samplesFFT_2);
+  if (!fftIm)     fftIm     = (int32_t*) calloc(sizeof(int32_t), samplesFFT_2);
+  if (!fftWindow || !fftCos || !fftSin || !fftRe || !fftIm) return false;
+  constexpr double Q30 = 1 << 30;
+  for (int i = 0; i < samplesFFT; i++) {
+    // same "Flat Top" window as ArduinoFFT
+    double ratio = double(i) / double(samplesFFT - 1);
+    fftWindow[i] = lround((0.2810639 - 0.5208972 * cos(2.0 * M_PI * ratio) + 0.1980399 * cos(4.0 * M_PI * ratio)) * Q30);
+  }
+  for (int k = 0; k < samplesFFT_2; k++) {
+    fftCos[k] = lround(cos(2.0 * M_PI * k / samplesFFT) * Q30);
+    fftSin[k] = lround(sin(2.0 * M_PI * k / samplesFFT) * Q30);
+  }
+  return true;
+}
+
+// removes DC, applies window and computes magnitudes of bins 0..samplesFFT/2 into samples[] (same results as ArduinoFFT)
+static void computeRealFFT(float *samples) {
+  float mean = 0.0f, peak = 0.0f;
+  for (int i = 0; i < samplesFFT; i++) mean += samples[i];
+  mean /= samplesFFT;
+  for (int i = 0; i < samplesFFT; i++) peak = fmaxf(peak, fabsf(samples[i] - mean));
+  if (peak < 1e-6f) { memset(samples, 0, samplesFFT * sizeof(float)); return; }
+  // scale to +/-2^27, each FFT stage scales down by 2 so values cannot grow (3 bits headroom for butterflies and split step)
+  const float scale = float(1 << 27) / peak;
+  // pack even samples as real and odd samples as imaginary part, in bit-reversed order
+  for (int i = 0, j = 0; i < samplesFFT_2; i++) {
+    fftRe[j] = mulQ30(lrintf((samples[2*i]   - mean) * scale), fftWindow[2*i]);
+    fftIm[j] = mulQ30(lrintf((samples[2*i+1] - mean) * scale), fftWindow[2*i+1]);
+    int bit = samplesFFT_4;                     // bit-reversed increment of j
+    for (; j & bit; bit >>= 1) j ^= bit;
+    j |= bit;
+  }
+  // radix-2 decimation in time, twiddle factors of a samplesFFT_2 point FFT are every other entry of the table
+  for (int len = 2, step = samplesFFT_2; len <= samplesFFT_2; len <<= 1, step >>= 1) {
+    const int half = len >> 1;
+    for (int i = 0; i < samplesFFT_2; i += len) {
+      for (int k = 0; k < half; k++) {
+        const int a = i + k, b = a + half;
+        const int32_t wr = fftCos[k * step], wi = fftSin[k * step]; // W = wr - j*wi
+        const int32_t tr = mulQ30(fftRe[b], wr) + mulQ30(fftIm[b], wi);
+        const int32_t ti = mulQ30(fftIm[b], wr) - mulQ30(fftRe[b], wi);
+        fftRe[b] = (fftRe[a] - tr) >> 1; fftIm[b] = (fftIm[a] - ti) >> 1;  // scale down each stage, keeps magnitudes < 2^21
+        fftRe[a] = (fftRe[a] + tr) >> 1; fftIm[a] = (fftIm[a] + ti) >> 1;
+      }
+    }
+  }
+  // split: X[k] = (Z[k] + conj(Z[N/2-k]))/2 + W^k * (Z[k] - conj(Z[N/2-k]))/2j
+  const float unscale = float(samplesFFT_2) / scale;  // undo input scaling and per-stage downscaling
+  samples[0] = fabsf(float(fftRe[0] + fftIm[0])) * unscale;
+  samples[samplesFFT_2] = fabsf(float(fftRe[0] - fftIm[0])) * unscale;
+  for (int k = 1; k < samplesFFT_2; k++) {
+    const int m = samplesFFT_2 - k;
+    const int32_t er = (fftRe[k] + fftRe[m]) >> 1, ei = (fftIm[k] - fftIm[m]) >> 1;
+    const int32_t or_ = (fftIm[k] + fftIm[m]) >> 1, oi = (fftRe[m] - fftRe[k]) >> 1;
+    const float xr = er + mulQ30(or_, fftCos[k]) + mulQ30(oi, fftSin[k]);
+    const float xi = ei + mulQ30(oi, fftCos[k]) - mulQ30(or_, fftSin[k]);
+    samples[k] = sqrtf(xr * xr + xi * xi) * unscale;
+  }
+  for (int k = 1; k < samplesFFT_2; k++) samples[samplesFFT - k] = samples[k]; // mirror, like a complex FFT of real input
+}
+
+// strongest frequency (interpolated) and its magnitude in bins[] (computeRealFFT() result), same as ArduinoFFT::majorPeak()
+static void fftMajorPeak(const float *bins, float sampleRate, float *frequency, float *value) {
+  float maxY = 0.0f;
+  int indexOfMaxY = 0;
+  for (int i = 1; i <= samplesFFT_2; i++) {
+    if ((bins[i-1] < bins[i]) && (bins[i] > bins[i+1]) && (bins[i] > maxY)) {
+      maxY = bins[i];
+      indexOfMaxY = i;
+    }
+  }
+  if (indexOfMaxY == 0) { *frequency = 0.0f; *value = 0.0f; return; }
+  float curvature = bins[indexOfMaxY-1] - 2.0f * bins[indexOfMaxY] + bins[indexOfMaxY+1];
+  float delta = 0.5f * (bins[indexOfMaxY-1] - bins[indexOfMaxY+1]) / curvature;
+  *frequency = ((indexOfMaxY + delta) * sampleRate) / (indexOfMaxY == samplesFFT_2 ? samplesFFT : samplesFFT - 1);
+  *value = fabsf(curvature);
+}
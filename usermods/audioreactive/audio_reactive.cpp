@@ -151,7 +151,6 @@ static bool useBandPassFilter = false;                    // if true, enables a
 ////////////////////
 
 // some prototypes, to ensure consistent interfaces
-static float fftAddAvg(int from, int to);   // average of several FFT result bins
 void FFTcode(void * parameter);      // audio processing task: read samples, run FFT, fill GEQ channels from FFT results
 static void runMicFilter(uint16_t numSamples, float *sampleBuffer);          // pre-filtering of raw samples (band-pass)
 static void postProcessFFTResults(bool noiseGateOpen, int numberOfChannels); // post-processing and post-amp of GEQ channels
@@ -194,6 +193,7 @@ constexpr uint16_t samplesFFT_2 = 256;          // meaningfull part of FFT resul
 
 // These are the input and output vectors.  Input vectors receive computed results from FFT.
 static float* vReal = nullptr;                  // FFT sample inputs / freq output -  these are our raw result bins
+#ifndef UM_AUDIOREACTIVE_USE_INTEGER_FFT
 static float* vImag = nullptr;                  // imaginary parts
 
 // Create FFT object
@@ -205,16 +205,54 @@ static float* vImag = nullptr;                  // imaginary parts
 // #define sqrt_internal sqrtf          // see https://github.com/kosme/arduinoFFT/pull/83 - since v2.0.0 this must be done in build_flags
 
 #include <arduinoFFT.h>             // FFT object is created in FFTcode
+#else
+#include "audio_fft.h"                // fixed point real-input FFT, also built by the native tests (test/test_fft)
+#endif
 // Helper functions
 
-// compute average of several FFT result bins
-static float fftAddAvg(int from, int to) {
-  float result = 0.0f;
-  for (int i = from; i <= to; i++) {
-    result += vReal[i];
+// mapping of FFT result bins to frequency channels: first bin, last bin and weight (damping / number of bins).
+// optimized for 22050 Hz by softhack007, channels 0-3 and 15 skip frequencies below 100hz if band pass filter is used.
+typedef struct GEQChannelBins {
+  uint8_t from, to;
+  float   weight;
+} geq_channel_bins_t;
+static const geq_channel_bins_t geqChannelBins[2][NUM_GEQ_CHANNELS] = {
+  {                         // bins frequency  range
+    {  1,   2, 1.00f/ 2},   // 1    43 - 86   sub-bass
+    {  2,   3, 1.00f/ 2},   // 1    86 - 129  bass
+    {  3,   5, 1.00f/ 3},   // 2   129 - 216  bass
+    {  5,   7, 1.00f/ 3},   // 2   216 - 301  bass + midrange
+    {  7,  10, 1.00f/ 4},   // 3   301 - 430  midrange
+    { 10,  13, 1.00f/ 4},   // 3   430 - 560  midrange
+    { 13,  19, 1.00f/ 7},   // 5   560 - 818  midrange
+    { 19,  26, 1.00f/ 8},   // 7   818 - 1120 midrange -- 1Khz should always be the center !
+    { 26,  33, 1.00f/ 8},   // 7  1120 - 1421 midrange
+    { 33,  44, 1.00f/12},   // 9  1421 - 1895 midrange
+    { 44,  56, 1.00f/13},   // 12 1895 - 2412 midrange + high mid
+    { 56,  70, 1.00f/15},   // 14 2412 - 3015 high mid
+    { 70,  86, 1.00f/17},   // 16 3015 - 3704 high mid
+    { 86, 104, 1.00f/19},   // 18 3704 - 4479 high mid
+    {104, 165, 0.88f/62},   // 61 4479 - 7106 high mid + high  -- with slight damping
+    {165, 215, 0.70f/51}    // 50 7106 - 9259 high             -- with some damping. don't use the last bins from 216 to 255. They are usually contaminated by aliasing (aka noise)
+  }, {
+    {  3,   4, 0.80f/ 2},
+    {  4,   5, 0.90f/ 2},
+    {  5,   6, 1.00f/ 2},
+    {  6,   7, 1.00f/ 2},
+    {  7,  10, 1.00f/ 4},
+    { 10,  13, 1.00f/ 4},
+    { 13,  19, 1.00f/ 7},
+    { 19,  26, 1.00f/ 8},
+    { 26,  33, 1.00f/ 8},
+    { 33,  44, 1.00f/12},
+    { 44,  56, 1.00f/13},
+    { 56,  70, 1.00f/15},
+    { 70,  86, 1.00f/17},
+    { 86, 104, 1.00f/19},
+    {104, 165, 0.88f/62},
+    {165, 205, 0.75f/41}    // don't use the last bins from 206 to 255.
   }
-  return result / float(to - from + 1);
-}
+};
 
 //
 // FFT main task
@@ -225,6 +263,9 @@ void FFTcode(void * parameter)
 
   // allocate FFT buffers on first call
   if (vReal == nullptr) vReal = (float*) calloc(sizeof(float), samplesFFT);
+#ifdef UM_AUDIOREACTIVE_USE_INTEGER_FFT
+  if ((vReal == nullptr) || !allocRealFFT()) return; // something went wrong
+#else
   if (vImag == nullptr) vImag = (float*) calloc(sizeof(float), samplesFFT);
   if ((vReal == nullptr) || (vImag == nullptr)) {
     // something went wrong
@@ -234,6 +275,7 @@ void FFTcode(void * parameter)
   }
   // Create FFT object with weighing factor storage
   ArduinoFFT<float> FFT = ArduinoFFT<float>( vReal, vImag, samplesFFT, SAMPLE_RATE, true);
+#endif
 
   // see https://www.freertos.org/vtaskdelayuntil.html
   const TickType_t xFrequency = FFT_MIN_CYCLE * portTICK_PERIOD_MS;  
@@ -256,7 +298,9 @@ void FFTcode(void * parameter)
 
     // get a fresh batch of samples from I2S
     if (audioSource) audioSource->getSamples(vReal, samplesFFT);
+#ifndef UM_AUDIOREACTIVE_USE_INTEGER_FFT
     memset(vImag, 0, samplesFFT * sizeof(float));   // set imaginary parts to 0
+#endif
 
 #if defined(WLED_DEBUG) || defined(SR_DEBUG)
     if (start < esp_timer_get_time()) { // filter out overflows
@@ -289,6 +333,11 @@ void FFTcode(void * parameter)
     if (sampleAvg > 0.25f) { // noise gate open means that FFT results will be used. Don't run FFT if results are not needed.
 #endif
 
+#ifdef UM_AUDIOREACTIVE_USE_INTEGER_FFT
+      computeRealFFT(vReal);                                      // remove DC offset, "Flat Top" window, FFT and magnitudes
+      vReal[0] = 0;   // The remaining DC offset on the signal produces a strong spike on position 0 that should be eliminated to avoid issues.
+      fftMajorPeak(vReal, SAMPLE_RATE, &FFT_MajorPeak, &FFT_Magnitude); // let the effects know which freq was most dominant
+#else
       // run FFT (takes 3-5ms on ESP32, ~12ms on ESP32-S2)
       FFT.dcRemoval();                                            // remove DC offset
       FFT.windowing( FFTWindow::Flat_top, FFTDirection::Forward); // Weigh data using "Flat Top" function - better amplitude accuracy
@@ -298,6 +347,7 @@ void FFTcode(void * parameter)
       vReal[0] = 0;   // The remaining DC offset on the signal produces a strong spike on position 0 that should be eliminated to avoid issues.
 
       FFT.majorPeak(&FFT_MajorPeak, &FFT_Magnitude);                // let the effects know which freq was most dominant
+#endif
       FFT_MajorPeak = constrain(FFT_MajorPeak, 1.0f, 11025.0f);   // restrict value to range expected by effects
 
 #if defined(WLED_DEBUG) || defined(SR_DEBUG)
@@ -317,63 +367,12 @@ void FFTcode(void * parameter)
 
     // mapping of FFT result bins to frequency channels
     if (fabsf(sampleAvg) > 0.5f) { // noise gate open
-#if 0
-    /* This FFT post processing is a DIY endeavour. What we really need is someone with sound engineering expertise to do a great job here AND most importantly, that the animations look GREAT as a result.
-    *
-    * Andrew's updated mapping of 256 bins down to the 16 result bins with Sample Freq = 10240, samplesFFT = 512 and some overlap.
-    * Based on testing, the lowest/Start frequency is 60 Hz (with bin 3) and a highest/End frequency of 5120 Hz in bin 255.
-    * Now, Take the 60Hz and multiply by 1.320367784 to get the next frequency and so on until the end. Then determine the bins.
-    * End frequency = Start frequency * multiplier ^ 16
-    * Multiplier = (End frequency/ Start frequency) ^ 1/16
-    * Multiplier = 1.320367784
-    */                                    //  Range
-      fftCalc[ 0] = fftAddAvg(2,4);       // 60 - 100
-      fftCalc[ 1] = fftAddAvg(4,5);       // 80 - 120
-      fftCalc[ 2] = fftAddAvg(5,7);       // 100 - 160
-      fftCalc[ 3] = fftAddAvg(7,9);       // 140 - 200
-      fftCalc[ 4] = fftAddAvg(9,12);      // 180 - 260
-      fftCalc[ 5] = fftAddAvg(12,16);     // 240 - 340
-      fftCalc[ 6] = fftAddAvg(16,21);     // 320 - 440
-      fftCalc[ 7] = fftAddAvg(21,29);     // 420 - 600
-      fftCalc[ 8] = fftAddAvg(29,37);     // 580 - 760
-      fftCalc[ 9] = fftAddAvg(37,48);     // 740 - 980
-      fftCalc[10] = fftAddAvg(48,64);     // 960 - 1300
-      fftCalc[11] = fftAddAvg(64,84);     // 1280 - 1700
-      fftCalc[12] = fftAddAvg(84,111);    // 1680 - 2240
-      fftCalc[13] = fftAddAvg(111,147);   // 2220 - 2960
-      fftCalc[14] = fftAddAvg(147,194);   // 2940 - 3900
-      fftCalc[15] = fftAddAvg(194,250);   // 3880 - 5000 // avoid the last 5 bins, which are usually inaccurate
-#else
-      /* new mapping, optimized for 22050 Hz by softhack007 */
-                                                    // bins frequency  range
-      if (useBandPassFilter) {
-        // skip frequencies below 100hz
-        fftCalc[ 0] = 0.8f * fftAddAvg(3,4);
-        fftCalc[ 1] = 0.9f * fftAddAvg(4,5);
-        fftCalc[ 2] = fftAddAvg(5,6);
-        fftCalc[ 3] = fftAddAvg(6,7);
-        // don't use the last bins from 206 to 255. 
-        fftCalc[15] = fftAddAvg(165,205) * 0.75f;   // 40 7106 - 8828 high             -- with some damping
-      } else {
-        fftCalc[ 0] = fftAddAvg(1,2);               // 1    43 - 86   sub-bass
-        fftCalc[ 1] = fftAddAvg(2,3);               // 1    86 - 129  bass
-        fftCalc[ 2] = fftAddAvg(3,5);               // 2   129 - 216  bass
-        fftCalc[ 3] = fftAddAvg(5,7);               // 2   216 - 301  bass + midrange
-        // don't use the last bins from 216 to 255. They are usually contaminated by aliasing (aka noise) 
-        fftCalc[15] = fftAddAvg(165,215) * 0.70f;   // 50 7106 - 9259 high             -- with some damping
+      const geq_channel_bins_t *bins = geqChannelBins[useBandPassFilter ? 1 : 0];
+      for (int i = 0; i < NUM_GEQ_CHANNELS; i++) {
+        float sum = 0.0f;
+        for (int b = bins[i].from; b <= bins[i].to; b++) sum += vReal[b];
+        fftCalc[i] = sum * bins[i].weight;
       }
-      fftCalc[ 4] = fftAddAvg(7,10);                // 3   301 - 430  midrange
-      fftCalc[ 5] = fftAddAvg(10,13);               // 3   430 - 560  midrange
-      fftCalc[ 6] = fftAddAvg(13,19);               // 5   560 - 818  midrange
-      fftCalc[ 7] = fftAddAvg(19,26);               // 7   818 - 1120 midrange -- 1Khz should always be the center !
-      fftCalc[ 8] = fftAddAvg(26,33);               // 7  1120 - 1421 midrange
-      fftCalc[ 9] = fftAddAvg(33,44);               // 9  1421 - 1895 midrange
-      fftCalc[10] = fftAddAvg(44,56);               // 12 1895 - 2412 midrange + high mid
-      fftCalc[11] = fftAddAvg(56,70);               // 14 2412 - 3015 high mid
-      fftCalc[12] = fftAddAvg(70,86);               // 16 3015 - 3704 high mid
-      fftCalc[13] = fftAddAvg(86,104);              // 18 3704 - 4479 high mid
-      fftCalc[14] = fftAddAvg(104,165) * 0.88f;     // 61 4479 - 7106 high mid + high  -- with slight damping
-#endif
     } else {  // noise gate closed - just decay old values
       for (int i=0; i < NUM_GEQ_CHANNELS; i++) {
         fftCalc[i] *= 0.85f;  // decay to zero
@@ -592,13 +591,13 @@ class AudioReactive : public Usermod {
     // new "V2" audiosync struct - 44 Bytes
     struct __attribute__ ((packed)) audioSyncPacket {  // "packed" ensures that there are no additional gaps
       char    header[6];      //  06 Bytes  offset 0
-      uint8_t reserved1[2];   //  02 Bytes, offset 6  - gap required by the compiler - not used yet 
+      uint16_t seq;           //  02 Bytes, offset 6  - packet sequence number, 0 = not set (older versions)
       float   sampleRaw;      //  04 Bytes  offset 8  - either "sampleRaw" or "rawSampleAgc" depending on soundAgc setting
       float   sampleSmth;     //  04 Bytes  offset 12 - either "sampleAvg" or "sampleAgc" depending on soundAgc setting
       uint8_t samplePeak;     //  01 Bytes  offset 16 - 0 no peak; >=1 peak detected. In future, this will also provide peak Magnitude
       uint8_t reserved2;      //  01 Bytes  offset 17 - for future extensions - not used yet
       uint8_t fftResult[16];  //  16 Bytes  offset 18
-      uint16_t reserved3;     //  02 Bytes, offset 34 - gap required by the compiler - not used yet
+      uint16_t timeStamp;     //  02 Bytes, offset 34 - sender millis() (lower 16 bits), only valid if seq != 0
       float  FFT_Magnitude;   //  04 Bytes  offset 36
       float  FFT_MajorPeak;   //  04 Bytes  offset 40
     };
@@ -634,6 +633,26 @@ class AudioReactive : public Usermod {
     unsigned long lastTime = 0;   // last time of running UDP Microphone Sync
     const uint16_t delayMs = 10;  // I don't want to sample too often and overload WLED
     uint16_t audioSyncPort= 11988;// default port for UDP sound sync
+    uint16_t audioSyncLatency = 60; // receive mode: timestamped packets are played this many ms after they were sent (0 = on arrival)
+    uint16_t audioSyncSeq = 0;    // send mode: sequence number of last packet
+
+    // receiver side jitter buffer: packets with timestamp are played out with a fixed latency (relative to the sender's
+    // clock) and interpolated, so all receivers show the same audio frame at the same time regardless of WiFi jitter
+    #define AUDIOSYNC_BUFFER      8    // packets (sender transmits every 20ms)
+    #define AUDIOSYNC_MAX_LATENCY 150  // ms, must fit into buffer
+    struct audioSyncFrame {
+      uint32_t time;                   // sender time (unwrapped)
+      audioSyncPacket packet;
+    };
+    audioSyncFrame syncBuffer[AUDIOSYNC_BUFFER]; // sorted by time
+    uint8_t  syncFrames = 0;
+    bool     syncTimestamped = false;  // last packet had a timestamp
+    uint16_t syncLastSeq = 0;
+    uint32_t syncSenderTime = 0;       // last (unwrapped) sender time
+    uint32_t syncPlayedTime = 0;       // sender time of last played out position
+    int32_t  syncClockOffset = 0;      // min(local time - sender time), i.e. sender clock + fastest network delay
+    unsigned long syncOffsetLeak = 0;  // last time offset was relaxed (clock drift)
+    uint32_t syncReceived = 0, syncLost = 0, syncLate = 0; // statistics
 
     bool updateIsRunning = false; // true during OTA.
 
@@ -1011,6 +1030,10 @@ class AudioReactive : public Usermod {
       transmitData.FFT_Magnitude = my_magnitude;
       transmitData.FFT_MajorPeak = FFT_MajorPeak;
 
+      if (++audioSyncSeq == 0) audioSyncSeq = 1; // 0 means "no sequence number"
+      transmitData.seq       = audioSyncSeq;
+      transmitData.timeStamp = millis() & 0xFFFF;
+
       if (fftUdp.beginMulticastPacket() != 0) { // beginMulticastPacket returns 0 in case of error
         fftUdp.write(reinterpret_cast<uint8_t *>(&transmitData), sizeof(transmitData));
         fftUdp.endPacket();
@@ -1032,6 +1055,12 @@ class AudioReactive : public Usermod {
       memset(&receivedPacket, 0, sizeof(receivedPacket));                                  // start clean
       memcpy(&receivedPacket, fftBuff, min((unsigned)packetSize, (unsigned)sizeof(receivedPacket))); // don't violate alignment - thanks @willmmiles#
 
+      syncTimestamped = receivedPacket.seq != 0 && audioSyncLatency > 0;
+      if (syncTimestamped) bufferAudioData(receivedPacket);
+      else applyAudioData(receivedPacket);
+    }
+
+    void applyAudioData(const audioSyncPacket &receivedPacket) {
       // update samples for effects
       volumeSmth   = fmaxf(receivedPacket.sampleSmth, 0.0f);
       volumeRaw    = fmaxf(receivedPacket.sampleRaw, 0.0f);
@@ -1058,6 +1087,87 @@ class AudioReactive : public Usermod {
       FFT_MajorPeak = constrain(receivedPacket.FFT_MajorPeak, 1.0f, 11025.0f);  // restrict value to range expected by effects
     }
 
+    void resetAudioSyncBuffer(void) {
+      syncFrames = 0;
+      syncPlayedTime = 0;
+    }
+
+    // adds timestamped packet to jitter buffer
+    void bufferAudioData(const audioSyncPacket &packet) {
+      int16_t  seqGap = packet.seq - syncLastSeq;  // <= 0: reordered packet (arrives after a newer one)
+      if (seqGap > 0 && packet.seq < syncLastSeq) seqGap--;       // wrapped forward across 0, which the sender skips
+      else if (seqGap < 0 && packet.seq > syncLastSeq) seqGap++;  // reordered packet from before the wrap
+      uint32_t time = syncSenderTime + int16_t(packet.timeStamp - uint16_t(syncSenderTime)); // unwrap 16 bit sender time
+      int32_t  offset = int32_t(millis() - time);
+      syncReceived++;
+      if (syncFrames == 0 || abs(offset - syncClockOffset) > 1000 || seqGap > AUDIOSYNC_BUFFER * 4 || seqGap < -AUDIOSYNC_BUFFER * 4) {
+        // (re)start: first packet, sender restarted or long gap
+        resetAudioSyncBuffer();
+        time = packet.timeStamp;
+        offset = int32_t(millis() - time);
+        syncClockOffset = offset;
+        syncOffsetLeak = millis();
+        seqGap = 1;
+      }
+      if (seqGap > 0) {
+        syncLost += seqGap - 1;
+        syncLastSeq = packet.seq;
+        syncSenderTime = time;
+      } else if (syncLost) syncLost--;  // reordered packet was counted as lost
+
+      // track fastest network delay, relax slowly to follow clock drift
+      if (offset < syncClockOffset) syncClockOffset = offset;
+      else if (millis() - syncOffsetLeak > 1000) { syncClockOffset++; syncOffsetLeak = millis(); }
+
+      if (syncPlayedTime && int32_t(time - syncPlayedTime) <= 0) { syncLate++; return; } // too late to be played
+      int pos = syncFrames;                         // insert sorted by time
+      while (pos > 0 && int32_t(syncBuffer[pos-1].time - time) > 0) pos--;
+      if (pos > 0 && syncBuffer[pos-1].time == time) return; // duplicate
+      if (syncFrames == AUDIOSYNC_BUFFER) {         // full, drop oldest
+        if (pos == 0) return;
+        memmove(&syncBuffer[0], &syncBuffer[1], --pos * sizeof(audioSyncFrame));
+        syncFrames--;
+      }
+      memmove(&syncBuffer[pos+1], &syncBuffer[pos], (syncFrames - pos) * sizeof(audioSyncFrame));
+      syncBuffer[pos].time = time;
+      memcpy(&syncBuffer[pos].packet, &packet, sizeof(audioSyncPacket));
+      syncFrames++;
+    }
+
+    // plays jitter buffer at (local time - clock offset - latency), interpolating between packets
+    // returns true if new audio data was applied
+    bool playAudioSyncBuffer(void) {
+      if (syncFrames == 0) return false;
+      uint32_t playTime = millis() - syncClockOffset - min(audioSyncLatency, (uint16_t)AUDIOSYNC_MAX_LATENCY);
+      if (int32_t(playTime - syncBuffer[0].time) < 0) return false; // first packet not due yet
+      if (syncFrames == 1 && int32_t(playTime - syncBuffer[0].time) > 500) return false; // sender stopped, hold last value
+      // drop packets that have been passed by the next one (keep one before play time)
+      int n = 0;
+      while (n + 1 < syncFrames && int32_t(playTime - syncBuffer[n+1].time) >= 0) n++;
+      // peaks of all packets passed since last call
+      bool peak = false;
+      for (int i = 0; i <= n; i++) if (int32_t(syncBuffer[i].time - syncPlayedTime) > 0 || !syncPlayedTime) peak |= syncBuffer[i].packet.samplePeak;
+      if (n) {
+        memmove(&syncBuffer[0], &syncBuffer[n], (syncFrames - n) * sizeof(audioSyncFrame));
+        syncFrames -= n;
+      }
+      syncPlayedTime = playTime;
+
+      audioSyncPacket frame = syncBuffer[0].packet;
+      if (syncFrames > 1) { // interpolate towards next packet (otherwise hold last one, i.e. packet is missing)
+        const audioSyncPacket &next = syncBuffer[1].packet;
+        float f = float(playTime - syncBuffer[0].time) / float(syncBuffer[1].time - syncBuffer[0].time);
+        frame.sampleRaw  += (next.sampleRaw  - frame.sampleRaw)  * f;
+        frame.sampleSmth += (next.sampleSmth - frame.sampleSmth) * f;
+        for (int i = 0; i < NUM_GEQ_CHANNELS; i++) frame.fftResult[i] += (int(next.fftResult[i]) - int(frame.fftResult[i])) * f;
+        frame.FFT_Magnitude += (next.FFT_Magnitude - frame.FFT_Magnitude) * f;
+        frame.FFT_MajorPeak += (next.FFT_MajorPeak - frame.FFT_MajorPeak) * f;
+      }
+      frame.samplePeak = peak;
+      applyAudioData(frame);
+      return true;
+    }
+
     void decodeAudioData_v1(int packetSize, uint8_t *fftBuff) {
       audioSyncPacket_v1 *receivedPacket = reinterpret_cast<audioSyncPacket_v1*>(fftBuff);
       // update samples for effects
@@ -1091,28 +1201,31 @@ class AudioReactive : public Usermod {
       if (!udpSyncConnected) return false;
       bool haveFreshData = false;
 
-      size_t packetSize = fftUdp.parsePacket();
+      for (int n = 0; n < AUDIOSYNC_BUFFER; n++) { // read all pending packets, they may arrive in bursts
+        size_t packetSize = fftUdp.parsePacket();
+        if (packetSize == 0) break;
 #ifdef ARDUINO_ARCH_ESP32
-      if ((packetSize > 0) && ((packetSize < 5) || (packetSize > UDPSOUND_MAX_PACKET))) fftUdp.flush(); // discard invalid packets (too small or too big) - only works on esp32
+        if ((packetSize > 0) && ((packetSize < 5) || (packetSize > UDPSOUND_MAX_PACKET))) fftUdp.flush(); // discard invalid packets (too small or too big) - only works on esp32
 #endif
-      if ((packetSize > 5) && (packetSize <= UDPSOUND_MAX_PACKET)) {
-        //DEBUGSR_PRINTLN("Received UDP Sync Packet");
-        uint8_t fftBuff[UDPSOUND_MAX_PACKET+1] = { 0 }; // fixed-size buffer for receiving (stack), to avoid heap fragmentation caused by variable sized arrays
-        fftUdp.read(fftBuff, packetSize);
-
-        // VERIFY THAT THIS IS A COMPATIBLE PACKET
-        if (packetSize == sizeof(audioSyncPacket) && (isValidUdpSyncVersion((const char *)fftBuff))) {
-          decodeAudioData(packetSize, fftBuff);
-          //DEBUGSR_PRINTLN("Finished parsing UDP Sync Packet v2");
-          haveFreshData = true;
-          receivedFormat = 2;
-        } else {
-          if (packetSize == sizeof(audioSyncPacket_v1) && (isValidUdpSyncVersion_v1((const char *)fftBuff))) {
-            decodeAudioData_v1(packetSize, fftBuff);
-            //DEBUGSR_PRINTLN("Finished parsing UDP Sync Packet v1");
+        if ((packetSize > 5) && (packetSize <= UDPSOUND_MAX_PACKET)) {
+          //DEBUGSR_PRINTLN("Received UDP Sync Packet");
+          uint8_t fftBuff[UDPSOUND_MAX_PACKET+1] = { 0 }; // fixed-size buffer for receiving (stack), to avoid heap fragmentation caused by variable sized arrays
+          fftUdp.read(fftBuff, packetSize);
+
+          // VERIFY THAT THIS IS A COMPATIBLE PACKET
+          if (packetSize == sizeof(audioSyncPacket) && (isValidUdpSyncVersion((const char *)fftBuff))) {
+            decodeAudioData(packetSize, fftBuff);
+            //DEBUGSR_PRINTLN("Finished parsing UDP Sync Packet v2");
             haveFreshData = true;
-            receivedFormat = 1;
-          } else receivedFormat = 0; // unknown format
+            receivedFormat = 2;
+          } else {
+            if (packetSize == sizeof(audioSyncPacket_v1) && (isValidUdpSyncVersion_v1((const char *)fftBuff))) {
+              decodeAudioData_v1(packetSize, fftBuff);
+              //DEBUGSR_PRINTLN("Finished parsing UDP Sync Packet v1");
+              haveFreshData = true;
+              receivedFormat = 1;
+            } else receivedFormat = 0; // unknown format
+          }
         }
       }
       return haveFreshData;
@@ -1392,6 +1505,7 @@ class AudioReactive : public Usermod {
 #endif
             lastTime = millis();
           }
+          if (syncTimestamped) have_new_sample = playAudioSyncBuffer(); // timestamped packets are played out with fixed latency
           if (have_new_sample) syncVolumeSmth = volumeSmth;   // remember received sample
           else volumeSmth = syncVolumeSmth;                   // restore originally received sample for next run of dynamics limiter
           limitSampleDynamics();                              // run dynamics limiter on received volumeSmth, to hide jumps and hickups
@@ -1512,6 +1626,7 @@ class AudioReactive : public Usermod {
           fftUdp.stop();
           DEBUGSR_PRINTLN(F("AR onUpdateBegin(true): UDP connection closed."));
           receivedFormat = 0;
+          resetAudioSyncBuffer();
         }
       }
       if (enabled) disableSoundProcessing = init; // init = true means that OTA is just starting --> don't process audio
@@ -1667,6 +1782,11 @@ class AudioReactive : public Usermod {
         if (audioSyncEnabled && udpSyncConnected && (millis() - last_UDPTime < 2500)) {
             if (receivedFormat == 1) infoArr.add(F(" v1"));
             if (receivedFormat == 2) infoArr.add(F(" v2"));
+            if (receivedFormat == 2 && syncTimestamped && syncReceived) {
+              infoArr = user.createNestedArray(F("Sync packets lost"));
+              infoArr.add(roundf(1000.0f * (syncLost + syncLate) / float(syncReceived + syncLost)) / 10.0f);
+              infoArr.add(F(" %"));
+            }
         }
 
         #if defined(WLED_DEBUG) || defined(SR_DEBUG)
@@ -1817,6 +1937,7 @@ class AudioReactive : public Usermod {
       JsonObject sync = top.createNestedObject("sync");
       sync["port"] = audioSyncPort;
       sync["mode"] = audioSyncEnabled;
+      sync[F("latency")] = audioSyncLatency;
     }
 
 
@@ -1877,6 +1998,8 @@ class AudioReactive : public Usermod {
 #endif
       configComplete &= getJsonValue(top["sync"]["port"], audioSyncPort);
       configComplete &= getJsonValue(top["sync"]["mode"], audioSyncEnabled);
+      configComplete &= getJsonValue(top["sync"][F("latency")], audioSyncLatency);
+      audioSyncLatency = min(audioSyncLatency, (uint16_t)AUDIOSYNC_MAX_LATENCY);
 
       if (initDone) {
         // add/remove custom/audioreactive palettes
@@ -1931,6 +2054,7 @@ class AudioReactive : public Usermod {
       uiScript.print(F("addOption(dd,'Send',1);"));
 #endif
       uiScript.print(F("addOption(dd,'Receive',2);"));
+      uiScript.print(F("addInfo(ux+':sync:latency',1,'ms <i>(receive, 0-150)</i>');"));
 #ifdef ARDUINO_ARCH_ESP32
       uiScript.print(F("addInfo(ux+':digitalmic:type',1,'<i>requires reboot!</i>');"));  // 0 is field type, 1 is actual field
       uiScript.print(F("addInfo(uxp,0,'<i>sd/data/dout</i>','I2S SD');"));
@@ -932,32 +932,25 @@ static uint16_t chase(uint32_t color1, uint32_t color2, uint32_t color3, bool do
   if (chase_random)
   {
     color1 = SEGMENT.color_wheel(SEGENV.aux1);
-    for (unsigned i = a; i < SEGLEN; i++)
-      SEGMENT.setPixelColor(i, color1);
+    SEGMENT.fillRange(a, SEGLEN - a, color1);
   }
 
   //fill between points a and b with color2
   if (a < b)
   {
-    for (unsigned i = a; i < b; i++)
-      SEGMENT.setPixelColor(i, color2);
+    SEGMENT.fillRange(a, b - a, color2);
   } else {
-    for (unsigned i = a; i < SEGLEN; i++) //fill until end
-      SEGMENT.setPixelColor(i, color2);
-    for (unsigned i = 0; i < b; i++) //fill from start until b
-      SEGMENT.setPixelColor(i, color2);
+    SEGMENT.fillRange(a, SEGLEN - a, color2); //fill until end
+    SEGMENT.fillRange(0, b, color2);          //fill from start until b
   }
 
   //fill between points b and c with color2
   if (b < c)
   {
-    for (unsigned i = b; i < c; i++)
-      SEGMENT.setPixelColor(i, color3);
+    SEGMENT.fillRange(b, c - b, color3);
   } else {
-    for (unsigned i = b; i < SEGLEN; i++) //fill until end
-      SEGMENT.setPixelColor(i, color3);
-    for (unsigned i = 0; i < c; i++) //fill from start until c
-      SEGMENT.setPixelColor(i, color3);
+    SEGMENT.fillRange(b, SEGLEN - b, color3); //fill until end
+    SEGMENT.fillRange(0, c, color3);          //fill from start until c
   }
 
   return FRAMETIME;
@@ -1345,9 +1338,7 @@ uint16_t mode_rain() {
     } else {
       //shift all leds left
       uint32_t ctemp = SEGMENT.getPixelColor(0);
-      for (unsigned i = 0; i < SEGLEN - 1; i++) {
-        SEGMENT.setPixelColor(i, SEGMENT.getPixelColor(i+1));
-      }
+      SEGMENT.copyRange(0, 1, SEGLEN - 1);
       SEGMENT.setPixelColor(SEGLEN -1, ctemp); // wrap around
       SEGENV.aux0++;  // increase spark index
       SEGENV.aux1++;
@@ -1684,23 +1675,15 @@ uint16_t mode_tricolor_wipe(void) {
   }
 
   if(ledIndex < SEGLEN) { //wipe from 0 to 1
-    for (unsigned i = 0; i < SEGLEN; i++)
-    {
-      SEGMENT.setPixelColor(i, (i > ledOffset)? SEGCOLOR(0) : SEGCOLOR(1));
-    }
+    SEGMENT.fillRange(0, ledOffset +1, SEGCOLOR(1));
+    SEGMENT.fillRange(ledOffset +1, SEGLEN - ledOffset -1, SEGCOLOR(0));
   } else if (ledIndex < SEGLEN*2) { //wipe from 1 to 2
     ledOffset = ledIndex - SEGLEN;
-    for (unsigned i = ledOffset +1; i < SEGLEN; i++)
-    {
-      SEGMENT.setPixelColor(i, SEGCOLOR(1));
-    }
+    SEGMENT.fillRange(ledOffset +1, SEGLEN - ledOffset -1, SEGCOLOR(1));
   } else //wipe from 2 to 0
   {
     ledOffset = ledIndex - SEGLEN*2;
-    for (unsigned i = 0; i <= ledOffset; i++)
-    {
-      SEGMENT.setPixelColor(i, SEGCOLOR(0));
-    }
+    SEGMENT.fillRange(0, ledOffset +1, SEGCOLOR(0));
   }
 
   return FRAMETIME;
@@ -2257,10 +2240,11 @@ uint16_t mode_noise16_2() {
   unsigned scale = 1000;                                        // the "zoom factor" for the noise
   SEGENV.step += (1 + (SEGMENT.speed >> 1));
 
+  unsigned shift_x = SEGENV.step >> 6;                          // x as a function of time
+  uint16_t noiseLine[32];
   for (unsigned i = 0; i < SEGLEN; i++) {
-    unsigned shift_x = SEGENV.step >> 6;                        // x as a function of time
-    uint32_t real_x = (i + shift_x) * scale;                    // calculate the coordinates within the noise field
-    unsigned noise = perlin16(real_x, 0, 4223) >> 8;            // get the noise data and scale it down
+    if (i % 32 == 0) perlin16Line(noiseLine, min(32U, SEGLEN - i), (i + shift_x) * scale, 0, 4223, scale, 0, 0); // get the noise data for the next 32 pixels
+    unsigned noise = noiseLine[i % 32] >> 8;                    // scale noise data down
     unsigned index = sin8_t(noise * 3);                           // map led color based on noise data
 
     SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0, noise));
@@ -2275,13 +2259,13 @@ uint16_t mode_noise16_3() {
   unsigned scale = 800;                                       // the "zoom factor" for the noise
   SEGENV.step += (1 + SEGMENT.speed);
 
+  unsigned shift_x = 4223;                                    // no movement along x and y
+  unsigned shift_y = 1234;
+  uint32_t real_z = SEGENV.step*8;
+  uint16_t noiseLine[32];
   for (unsigned i = 0; i < SEGLEN; i++) {
-    unsigned shift_x = 4223;                                  // no movement along x and y
-    unsigned shift_y = 1234;
-    uint32_t real_x = (i + shift_x) * scale;                  // calculate the coordinates within the noise field
-    uint32_t real_y = (i + shift_y) * scale;                  // based on the precalculated positions
-    uint32_t real_z = SEGENV.step*8;
-    unsigned noise = perlin16(real_x, real_y, real_z) >> 8;   // get the noise data and scale it down
+    if (i % 32 == 0) perlin16Line(noiseLine, min(32U, SEGLEN - i), (i + shift_x) * scale, (i + shift_y) * scale, real_z, scale, scale, 0); // get the noise data for the next 32 pixels
+    unsigned noise = noiseLine[i % 32] >> 8;                  // scale noise data down
     unsigned index = sin8_t(noise * 3);                         // map led color based on noise data
 
     SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0, noise));
@@ -4492,7 +4476,7 @@ static const char _data_FX_MODE_WASHING_MACHINE[] PROGMEM = "Washing Machine@!,!
 
 /*
   Image effect
-  Draws a .gif image from filesystem on the matrix/strip
+  Draws a .gif image from filesystem on the matrix/strip (Smooth: bilinear scaling)
 */
 uint16_t mode_image(void) {
   #ifndef WLED_ENABLE_GIF
@@ -4506,7 +4490,7 @@ uint16_t mode_image(void) {
   //   Serial.println(status);
   // }
 }
-static const char _data_FX_MODE_IMAGE[] PROGMEM = "Image@!,;;;12;sx=128";
+static const char _data_FX_MODE_IMAGE[] PROGMEM = "Image@!,,,,,Smooth;;;12;sx=128";
 
 /*
   Blends random colors across palette
@@ -5538,10 +5522,11 @@ uint16_t mode_2Dnoise(void) {                  // By Andrew Tuline
 
   const unsigned scale  = SEGMENT.intensity+2;
 
+  uint8_t noiseRow[cols];
   for (int y = 0; y < rows; y++) {
+    perlin8Line(noiseRow, cols, 0, y * scale, strip.now / (16 - SEGMENT.speed/16), scale, 0, 0);
     for (int x = 0; x < cols; x++) {
-      uint8_t pixelHue8 = perlin8(x * scale, y * scale, strip.now / (16 - SEGMENT.speed/16));
-      SEGMENT.setPixelColorXY(x, y, ColorFromPalette(SEGPALETTE, pixelHue8));
+      SEGMENT.setPixelColorXY(x, y, ColorFromPalette(SEGPALETTE, noiseRow[x]));
     }
   }
 
@@ -6297,10 +6282,8 @@ uint16_t mode_2Dplasmarotozoom() {
   // plasma
   for (int j = 0; j < rows; j++) {
     int index = j*cols;
-    for (int i = 0; i < cols; i++) {
-      if (SEGMENT.check1) plasma[index+i] = (i * 4 ^ j * 4) + ms / 6;
-      else                plasma[index+i] = inoise8(i * 40, j * 40, ms);
-    }
+    if (SEGMENT.check1) for (int i = 0; i < cols; i++) plasma[index+i] = (i * 4 ^ j * 4) + ms / 6;
+    else                perlin8Line(&plasma[index], cols, 0, j * 40, ms, 40, 0, 0);
   }
 
   // rotozoom
@@ -6780,8 +6763,8 @@ uint16_t mode_pixelwave(void) {                 // Pixelwave. By Andrew Tuline.
     uint8_t pixBri = volumeRaw * SEGMENT.intensity / 64;
 
     SEGMENT.setPixelColor(SEGLEN/2, color_blend(SEGCOLOR(1), SEGMENT.color_from_palette(strip.now, false, PALETTE_SOLID_WRAP, 0), pixBri));
-    for (unsigned i = SEGLEN - 1; i > SEGLEN/2; i--) SEGMENT.setPixelColor(i, SEGMENT.getPixelColor(i-1)); //move to the left
-    for (unsigned i = 0; i < SEGLEN/2; i++)          SEGMENT.setPixelColor(i, SEGMENT.getPixelColor(i+1)); // move to the right
+    SEGMENT.copyRange(SEGLEN/2 + 1, SEGLEN/2, SEGLEN - SEGLEN/2 - 1); //move to the left
+    SEGMENT.copyRange(0, 1, SEGLEN/2);                                // move to the right
   }
 
   return FRAMETIME;
@@ -6959,9 +6942,8 @@ uint16_t mode_DJLight(void) {                   // Written by ??? Adapted by Wil
     CRGB color = CRGB(fftResult[15]/2, fftResult[5]/2, fftResult[0]/2); // 16-> 15 as 16 is out of bounds
     SEGMENT.setPixelColor(mid, color.fadeToBlackBy(map(fftResult[4], 0, 255, 255, 4)));     // TODO - Update
 
-    // if SEGLEN equals 1 these loops won't execute
-    for (int i = SEGLEN - 1; i > mid; i--)   SEGMENT.setPixelColor(i, SEGMENT.getPixelColor(i-1)); // move to the left
-    for (int i = 0; i < mid; i++)            SEGMENT.setPixelColor(i, SEGMENT.getPixelColor(i+1)); // move to the right
+    SEGMENT.copyRange(mid + 1, mid, SEGLEN - mid - 1); // move to the left
+    SEGMENT.copyRange(0, 1, mid);                      // move to the right
   }
 
   return FRAMETIME;
@@ -7045,8 +7027,7 @@ uint16_t mode_freqmatrix(void) {                // Freqmatrix. By Andreas Plesch
 
     // shift the pixels one pixel up
     SEGMENT.setPixelColor(0, color);
-    // if SEGLEN equals 1 this loop won't execute
-    for (int i = SEGLEN - 1; i > 0; i--) SEGMENT.setPixelColor(i, SEGMENT.getPixelColor(i-1)); //move to the left
+    SEGMENT.copyRange(1, 0, SEGLEN - 1); //move to the left
   }
 
   return FRAMETIME;
@@ -7141,9 +7122,8 @@ uint16_t mode_freqwave(void) {                  // Freqwave. By Andreas Pleschun
     SEGMENT.setPixelColor(SEGLEN/2, color);
 
     // shift the pixels one pixel outwards
-    // if SEGLEN equals 1 these loops won't execute
-    for (unsigned i = SEGLEN - 1; i > SEGLEN/2; i--) SEGMENT.setPixelColor(i, SEGMENT.getPixelColor(i-1)); //move to the left
-    for (unsigned i = 0; i < SEGLEN/2; i++)          SEGMENT.setPixelColor(i, SEGMENT.getPixelColor(i+1)); // move to the right
+    SEGMENT.copyRange(SEGLEN/2 + 1, SEGLEN/2, SEGLEN - SEGLEN/2 - 1); //move to the left
+    SEGMENT.copyRange(0, 1, SEGLEN/2);                                // move to the right
   }
 
   return FRAMETIME;
@@ -7636,11 +7616,13 @@ uint16_t mode_2Dsoap() {
   if (SEGENV.call == 0) for (int i = 0; i < 3; i++) noisecoord[i] = hw_random(); // init
   else                  for (int i = 0; i < 3; i++) noisecoord[i] += mov;
 
+  uint16_t noiseCol[rows];
   for (int i = 0; i < cols; i++) {
     int32_t ioffset = scale32_x * (i - cols / 2);
+    int32_t joffset = scale32_y * (0 - rows / 2);
+    perlin16Line(noiseCol, rows, noisecoord[0] + ioffset, noisecoord[1] + joffset, noisecoord[2], 0, scale32_y, 0);
     for (int j = 0; j < rows; j++) {
-      int32_t joffset = scale32_y * (j - rows / 2);
-      uint8_t data = perlin16(noisecoord[0] + ioffset, noisecoord[1] + joffset, noisecoord[2]) >> 8;
+      uint8_t data = noiseCol[j] >> 8;
       noise3d[XY(i,j)] = scale8(noise3d[XY(i,j)], smoothness) + scale8(data, 255 - smoothness);
     }
   }
@@ -10621,11 +10603,38 @@ static const char _data_FX_MODE_PS_SPRINGY[] PROGMEM = "PS Springy@Stiffness,Dam
 // mode data
 static const char _data_RESERVED[] PROGMEM = "RSVD";
 
+// single pass over effect metadata string to locate its sections (see ModeMeta)
+static mode_meta_t buildModeMeta(const char *data) {
+  mode_meta_t meta = {0, 0, 0, 0};
+  if (data == _data_RESERVED) {
+    meta.nameLen = 4;
+    meta.flags   = FX_META_RESERVED;
+    return meta;
+  }
+  bool     hasData  = false; // '@' found
+  unsigned section  = 0;     // ';' separated section
+  unsigned i        = 0;
+  for (char c; i < 255 && (c = pgm_read_byte(data + i)) != '\0'; i++) {
+    if (!hasData) {
+      if (c == '@') { meta.nameLen = i; hasData = true; }
+      continue;
+    }
+    if (c == ';') {
+      if (section == 0) meta.slidersEnd = i;
+      meta.defaultsAt = i;
+      section++;
+    }
+  }
+  if (!hasData) meta.nameLen = i;
+  return meta;
+}
+
 // add (or replace reserved) effect mode and data into vector
 // use id==255 to find unallocated gaps (with "Reserved" data string)
 // if vector size() is smaller than id (single) data is appended at the end (regardless of id)
 // return the actual id used for the effect or 255 if the add failed.
 uint8_t WS2812FX::addEffect(uint8_t id, mode_ptr mode_fn, const char *mode_name) {
+  invalidateJsonCache(); // effect list (/json/eff, /json/fxdata) will change
   if (id == 255) { // find empty slot
     for (size_t i=1; i<_mode.size(); i++) if (_modeData[i] == _data_RESERVED) { id = i; break; }
   }
@@ -10633,10 +10642,12 @@ uint8_t WS2812FX::addEffect(uint8_t id, mode_ptr mode_fn, const char *mode_name)
     if (_modeData[id] != _data_RESERVED) return 255; // do not overwrite an already added effect
     _mode[id]     = mode_fn;
     _modeData[id] = mode_name;
+    _modeMeta[id] = buildModeMeta(mode_name);
     return id;
   } else if (_mode.size() < 255) { // 255 is reserved for indicating the effect wasn't added
     _mode.push_back(mode_fn);
     _modeData.push_back(mode_name);
+    _modeMeta.push_back(buildModeMeta(mode_name));
     if (_modeCount < _mode.size()) _modeCount++;
     return _mode.size() - 1;
   } else {
@@ -10648,10 +10659,13 @@ void WS2812FX::setupEffectData() {
   // Solid must be first! (assuming vector is empty upon call to setup)
   _mode.push_back(&mode_static);
   _modeData.push_back(_data_FX_MODE_STATIC);
+  _modeMeta.push_back(buildModeMeta(_data_FX_MODE_STATIC));
   // fill reserved word in case there will be any gaps in the array
+  const mode_meta_t reserved = buildModeMeta(_data_RESERVED);
   for (size_t i=1; i<_modeCount; i++) {
     _mode.push_back(&mode_static);
     _modeData.push_back(_data_RESERVED);
+    _modeMeta.push_back(reserved);
   }
   // now replace all pre-allocated effects
   addEffect(FX_MODE_COPY, &mode_copy_segment, _data_FX_MODE_COPY);
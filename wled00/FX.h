@@ -414,6 +414,44 @@ typedef enum mapping1D2D {
   M12_sPinwheel = 4
 } mapping1D2D_t;
 
+// effect flags, see ModeMeta
+#define FX_META_RESERVED  0x80  // reserved (empty) effect slot
+
+// compact index into effect metadata string (e.g. "Juggle@!,Trail;!,!,;!;012;sx=16,ix=240")
+// built once when effect is added so that name, sliders and defaults can be located without scanning PROGMEM
+// offsets are limited to 255 characters which is more than any metadata string uses
+typedef struct ModeMeta {
+  uint8_t nameLen;     // length of effect name (offset of '@' or end of string)
+  uint8_t slidersEnd;  // offset of ';' terminating slider names (0 if there is no slider data)
+  uint8_t defaultsAt;  // offset of last ';' (start of parameter defaults, 0 if there is none)
+  uint8_t flags;       // FX_META_* flags
+} mode_meta_t;
+
+// run of ledmap entries (logical pixels from start up to start of next run) whose physical indices form an
+// arithmetic sequence target, target+stride, ... (typical for serpentine panels, rotations and gaps)
+// runs that would be too short are stored as explicit entries following the run array (stride == LEDMAP_EXPLICIT)
+#define LEDMAP_EXPLICIT INT16_MIN
+#define LEDMAP_MIN_RUN  3         // shorter runs are stored as explicit entries
+typedef struct LedmapRun {
+  uint16_t start;   // first logical pixel of the run
+  uint16_t target;  // physical index of first pixel (0xFFFF: missing pixels), offset into explicit entries if stride == LEDMAP_EXPLICIT
+  int16_t  stride;  // physical index increment per pixel
+} ledmap_run_t;
+
+// binary ledmap file (ledmapN.bin, takes precedence over ledmapN.json), created from JSON form by tools/ledmap2bin.py
+// header is followed by count uint16_t entries (little endian, 0xFFFF: missing pixel) which are read in a single block
+#define LEDMAP_BIN_MAGIC   0x504D4C57UL // "WLMP"
+#define LEDMAP_BIN_VERSION 1
+typedef struct LedmapFileHeader {
+  uint32_t magic;
+  uint8_t  version;
+  uint8_t  reserved;
+  uint16_t width;     // matrix width (0 if not specified)
+  uint16_t height;    // matrix height (0 if not specified)
+  uint16_t count;     // number of entries
+  char     name[32];  // ledmap name (zero terminated unless 32 characters long)
+} ledmap_header_t;
+
 class WS2812FX;
 
 // segment, 76 bytes
@@ -483,6 +521,7 @@ class Segment {
         bool    _manualW  : 1;
       };
     };
+    mutable uint8_t _budget;          // adaptive workload of the running effect (255 = full) if it scales its work to hold the frame rate, 0 if it does not
 
     // static variables are use to speed up effect calculations by stashing common pre-calculated values
     static unsigned      _usedSegmentData;    // amount of data used by all segments
@@ -543,6 +582,8 @@ class Segment {
     inline void     setPixelColorXYRaw(unsigned x, unsigned y, uint32_t c) const  { auto XY = [](unsigned X, unsigned Y){ return X + Y*Segment::vWidth(); }; pixels[XY(x,y)] = c; }
     inline uint32_t getPixelColorXYRaw(unsigned x, unsigned y) const              { auto XY = [](unsigned X, unsigned Y){ return X + Y*Segment::vWidth(); }; return pixels[XY(x,y)]; };
   #endif
+    inline bool     isLinear() const                                { return !is2D() || map1D2D == M12_Pixels; } // virtual (1D) pixel index equals raw buffer index
+    bool            clipRange(int &start, int &len) const;          // clip pixel range to virtual length, returns false if nothing is left
     void resetIfRequired();         // sets all SEGENV variables to 0 and clears data buffer
     CRGBPalette16 &loadPalette(CRGBPalette16 &tgt, uint8_t pal);
 
@@ -597,6 +638,7 @@ class Segment {
     , _dataLen(0)
     , _default_palette(6)
     , _capabilities(0)
+    , _budget(0)
     , _t(nullptr)
     {
       DEBUGFX_PRINTF_P(PSTR("-- Creating segment: %p [%d,%d:%d,%d]\n"), this, (int)start, (int)stop, (int)startY, (int)stopY);
@@ -645,6 +687,8 @@ class Segment {
     inline uint16_t length()               const { return width() * height(); }               // segment length (count) in physical pixels
     inline uint16_t groupLength()          const { return grouping + spacing; }
     inline uint8_t  getLightCapabilities() const { return _capabilities; }
+    inline uint8_t  getBudget()            const { return _budget; }
+    inline void     setBudget(uint8_t b)   const { _budget = b; }
     inline void     deactivate()                 { setGeometry(0,0); }
     inline Segment &clearName()                  { d_free(name); name = nullptr; return *this; }
     inline Segment &setName(const String &name)  { return setName(name.c_str()); }
@@ -713,6 +757,15 @@ class Segment {
                                                                                    { addPixelColor(n, RGBW32(r,g,b,w), preserveCR); }
     inline void addPixelColor(int n, CRGB c, bool preserveCR = true) const         { addPixelColor(n, RGBW32(c.r,c.g,c.b,0), preserveCR); }
     inline void fadePixelColor(uint16_t n, uint8_t fade) const                     { setPixelColor(n, color_fade(getPixelColor(n), fade, true)); }
+    // span functions (operate on len consecutive pixels starting at start, directly on the segment buffer where possible)
+    void fillRange(int start, int len, uint32_t c) const;
+    void fadeRange(int start, int len, uint8_t fadeBy) const;                     // fade towards black, same as fadeToBlackBy()
+    void blendRange(int start, int len, uint32_t c, uint8_t blend) const;
+    void addRange(int start, int len, uint32_t c, bool preserveCR = true) const;
+    void copyRange(int dst, int src, int len) const;                              // ranges may overlap
+    void shiftRange(int start, int len, int delta, uint32_t c = BLACK) const;     // shift pixels within range, vacated pixels are set to c
+    inline void fillRange(int start, int len, CRGB c) const                       { fillRange(start, len, RGBW32(c.r,c.g,c.b,0)); }
+    inline void blendRange(int start, int len, CRGB c, uint8_t blend) const       { blendRange(start, len, RGBW32(c.r,c.g,c.b,0), blend); }
     [[gnu::hot]] uint32_t color_from_palette(uint16_t, bool mapping, bool moving, uint8_t mcol, uint8_t pbri = 255) const;
     [[gnu::hot]] uint32_t color_wheel(uint8_t pos) const;
     // 2D matrix
@@ -758,6 +811,13 @@ class Segment {
     inline void blurRows(fract8 blur_amount, bool smear = false) const                         { blur2D(blur_amount, 0, smear); } // blur all rows (50% faster than full 2D blur)
     //void box_blur(unsigned r = 1U, bool smear = false); // 2D box blur
     void blur2D(uint8_t blur_x, uint8_t blur_y, bool smear = false) const;
+    void fillRow(int y, uint32_t c) const;
+    void fillColumn(int x, uint32_t c) const;
+    void fillRect(int x, int y, int w, int h, uint32_t c) const;
+    void getRow(int y, uint32_t *buf) const;          // copies vWidth() pixels into buf
+    void setRow(int y, const uint32_t *buf) const;
+    void getColumn(int x, uint32_t *buf) const;       // copies vHeight() pixels into buf
+    void setColumn(int x, const uint32_t *buf) const;
     void moveX(int delta, bool wrap = false) const;
     void moveY(int delta, bool wrap = false) const;
     void move(unsigned dir, unsigned delta, bool wrap = false) const;
@@ -795,6 +855,13 @@ class Segment {
     inline void blur2D(uint8_t blur_x, uint8_t blur_y, bool smear = false) {}
     inline void blurCols(fract8 blur_amount, bool smear = false) { blur(blur_amount, smear); } // blur all columns (50% faster than full 2D blur)
     inline void blurRows(fract8 blur_amount, bool smear = false) {}
+    inline void fillRow(int y, uint32_t c) const                                          { fillRange(0, vLength(), c); }
+    inline void fillColumn(int x, uint32_t c) const                                       { setPixelColor(x, c); }
+    inline void fillRect(int x, int y, int w, int h, uint32_t c) const                    { fillRange(x, w, c); }
+    inline void getRow(int y, uint32_t *buf) const                                        { for (unsigned i = 0; i < vLength(); i++) buf[i] = getPixelColor(i); }
+    inline void setRow(int y, const uint32_t *buf) const                                  { for (unsigned i = 0; i < vLength(); i++) setPixelColor(i, buf[i]); }
+    inline void getColumn(int x, uint32_t *buf) const                                     { buf[0] = getPixelColor(x); }
+    inline void setColumn(int x, const uint32_t *buf) const                               { setPixelColor(x, buf[0]); }
     inline void moveX(int delta, bool wrap = false) {}
     inline void moveY(int delta, bool wrap = false) {}
     inline void move(uint8_t dir, uint8_t delta, bool wrap = false) {}
@@ -857,13 +924,17 @@ class WS2812FX {
       _modeCount(MODE_COUNT),
       _callback(nullptr),
       customMappingTable(nullptr),
+      customMappingRuns(nullptr),
       customMappingSize(0),
+      customMappingRunCount(0),
+      _mapRunHint(0),
       _lastShow(0),
       _lastServiceShow(0)
     {
       _mode.reserve(_modeCount);     // allocate memory to prevent initial fragmentation (does not increase size())
       _modeData.reserve(_modeCount); // allocate memory to prevent initial fragmentation (does not increase size())
-      if (_mode.capacity() <= 1 || _modeData.capacity() <= 1) _modeCount = 1; // memory allocation failed only show Solid
+      _modeMeta.reserve(_modeCount);
+      if (_mode.capacity() <= 1 || _modeData.capacity() <= 1 || _modeMeta.capacity() <= 1) _modeCount = 1; // memory allocation failed only show Solid
       else setupEffectData();
     }
 
@@ -871,8 +942,10 @@ class WS2812FX {
       d_free(_pixels);
       d_free(_pixelCCT); // just in case
       d_free(customMappingTable);
+      d_free(customMappingRuns);
       _mode.clear();
       _modeData.clear();
+      _modeMeta.clear();
       _segments.clear();
 #ifndef WLED_DISABLE_2D
       panel.clear();
@@ -921,6 +994,7 @@ class WS2812FX {
     bool hasRGBWBus() const;
     bool hasCCTBus() const;
     bool deserializeMap(unsigned n = 0);
+    bool deserializeBinaryMap(File &f, unsigned n);
 
     inline bool isUpdating() const           { return !BusManager::canAllShow(); } // return true if the strip is being sent pixel updates
     inline bool isServicing() const          { return _isServicing; }           // returns true if strip.service() is executing
@@ -953,9 +1027,11 @@ class WS2812FX {
     inline uint16_t getLength() const       { return _length; }           // returns actual amount of LEDs on a strip (2D matrix may have less LEDs than W*H)
     inline uint16_t getTransition() const   { return _transitionDur; }    // returns currently set transition time (in ms)
     inline uint16_t getMappedPixelIndex(uint16_t index) const {           // convert logical address to physical
-      if (index < customMappingSize && (realtimeMode == REALTIME_MODE_INACTIVE || realtimeRespectLedMaps)) index = customMappingTable[index];
+      if (index < customMappingSize && (realtimeMode == REALTIME_MODE_INACTIVE || realtimeRespectLedMaps))
+        index = customMappingTable ? customMappingTable[index] : getMappedRunIndex(index);
       return index;
     };
+    uint16_t getMappedSpan(unsigned index, unsigned &len, int &stride) const; // physical address of index and number of pixels following it with constant stride
 
     unsigned long now, timebase;
     inline uint32_t getPixelColor(unsigned n) const { return (n < getLengthTotal()) ? _pixels[n] : 0; } // returns color of pixel n
@@ -963,6 +1039,7 @@ class WS2812FX {
 
     const char *getModeData(unsigned id = 0) const  { return (id && id < _modeCount) ? _modeData[id] : PSTR("Solid"); }
     inline const char **getModeDataSrc()            { return &(_modeData[0]); }           // vectors use arrays for underlying data
+    inline mode_meta_t getModeMeta(unsigned id) const { return id < _modeMeta.size() ? _modeMeta[id] : mode_meta_t{5, 0, 0, 0}; } // "Solid" if out of range
 
     Segment&        getSegment(unsigned id);
     inline Segment& getFirstSelectedSeg() { return _segments[getFirstSelectedSegId()]; }  // returns reference to first segment that is "selected"
@@ -1044,11 +1121,20 @@ class WS2812FX {
     uint8_t                  _modeCount;
     std::vector<mode_ptr>    _mode;     // SRAM footprint: 4 bytes per element
     std::vector<const char*> _modeData; // mode (effect) name and its slider control data array
+    std::vector<mode_meta_t> _modeMeta; // index into _modeData strings (4 bytes per element)
 
     show_callback _callback;
 
-    uint16_t* customMappingTable;
-    uint16_t  customMappingSize;
+    uint16_t*     customMappingTable;     // one entry per logical pixel (if mapping could not be compacted)
+    ledmap_run_t* customMappingRuns;      // runs followed by explicit entries (if customMappingTable == nullptr)
+    uint16_t      customMappingSize;
+    uint16_t      customMappingRunCount;
+    mutable uint16_t _mapRunHint;         // last used run (consecutive lookups are sequential)
+
+    uint16_t getMappedRunIndex(unsigned index) const;
+    unsigned findMappingRun(unsigned index) const;
+    void     compactMapping();            // converts customMappingTable into runs if that uses less RAM
+    void     freeMapping();
 
     unsigned long _lastShow;
     unsigned long _lastServiceShow;
@@ -51,7 +51,7 @@ void WS2812FX::setUpMatrix() {
 
     customMappingSize = 0; // prevent use of mapping if anything goes wrong
 
-    d_free(customMappingTable);
+    freeMapping();
     customMappingTable = static_cast<uint16_t*>(d_malloc(sizeof(uint16_t)*getLengthTotal())); // prefer to not use SPI RAM
 
     if (customMappingTable) {
@@ -114,7 +114,6 @@ void WS2812FX::setUpMatrix() {
 
       // delete gap array as we no longer need it
       p_free(gapTable);
-      resume();
 
       #ifdef WLED_DEBUG
       DEBUG_PRINT(F("Matrix ledmap:"));
@@ -124,6 +123,8 @@ void WS2812FX::setUpMatrix() {
       }
       DEBUG_PRINTLN();
       #endif
+      compactMapping();
+      resume();
     } else { // memory allocation error
       DEBUG_PRINTLN(F("ERROR 2D LED map allocation error."));
       isMatrix = false;
@@ -243,57 +244,8 @@ uint32_t IRAM_ATTR_YN Segment::getPixelColorXY(int x, int y) const {
 // 2D blurring, can be asymmetrical
 void Segment::blur2D(uint8_t blur_x, uint8_t blur_y, bool smear) const {
   if (!isActive()) return; // not active
-  const unsigned cols = vWidth();
-  const unsigned rows = vHeight();
-  const auto XY = [&](unsigned x, unsigned y){ return x + y*cols; };
-  uint32_t lastnew; // not necessary to initialize lastnew and last, as both will be initialized by the first loop iteration
-  uint32_t last;
-  if (blur_x) {
-    const uint8_t keepx = smear ? 255 : 255 - blur_x;
-    const uint8_t seepx = blur_x >> 1;
-    for (unsigned row = 0; row < rows; row++) { // blur rows (x direction)
-      uint32_t carryover = BLACK;
-      uint32_t curnew = BLACK;
-      for (unsigned x = 0; x < cols; x++) {
-        uint32_t cur = getPixelColorRaw(XY(x, row));
-        uint32_t part = color_fade(cur, seepx);
-        curnew = color_fade(cur, keepx);
-        if (x > 0) {
-          if (carryover) curnew = color_add(curnew, carryover);
-          uint32_t prev = color_add(lastnew, part);
-          // optimization: only set pixel if color has changed
-          if (last != prev) setPixelColorRaw(XY(x - 1, row), prev);
-        } else setPixelColorRaw(XY(x, row), curnew); // first pixel
-        lastnew = curnew;
-        last = cur; // save original value for comparison on next iteration
-        carryover = part;
-      }
-      setPixelColorRaw(XY(cols-1, row), curnew); // set last pixel
-    }
-  }
-  if (blur_y) {
-    const uint8_t keepy = smear ? 255 : 255 - blur_y;
-    const uint8_t seepy = blur_y >> 1;
-    for (unsigned col = 0; col < cols; col++) {
-      uint32_t carryover = BLACK;
-      uint32_t curnew = BLACK;
-      for (unsigned y = 0; y < rows; y++) {
-        uint32_t cur = getPixelColorRaw(XY(col, y));
-        uint32_t part = color_fade(cur, seepy);
-        curnew = color_fade(cur, keepy);
-        if (y > 0) {
-          if (carryover) curnew = color_add(curnew, carryover);
-          uint32_t prev = color_add(lastnew, part);
-          // optimization: only set pixel if color has changed
-          if (last != prev) setPixelColorRaw(XY(col, y - 1), prev);
-        } else setPixelColorRaw(XY(col, y), curnew); // first pixel
-        lastnew = curnew;
-        last = cur; //save original value for comparison on next iteration
-        carryover = part;
-      }
-      setPixelColorRaw(XY(col, rows - 1), curnew);
-    }
-  }
+  if (blur_x) blurPixelRows(pixels, vWidth(), vHeight(), blur_x, smear); // blur rows (x direction)
+  if (blur_y) blurPixelColumns(pixels, vWidth(), vHeight(), blur_y, smear); // blur columns (y direction)
 }
 
 /*
@@ -370,6 +322,52 @@ void Segment::box_blur(unsigned radius, bool smear) {
   delete[] tmpWSum;
 }
 */
+// row/column access: works directly on the segment buffer (rows are contiguous)
+void Segment::fillRow(int y, uint32_t c) const {
+  fillRect(0, y, vWidth(), 1, c);
+}
+
+void Segment::fillColumn(int x, uint32_t c) const {
+  fillRect(x, 0, 1, vHeight(), c);
+}
+
+void Segment::fillRect(int x, int y, int w, int h, uint32_t c) const {
+  if (!isActive()) return; // not active
+  const int vW = vWidth();
+  const int vH = vHeight();
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  w = min(w, vW - x);
+  h = min(h, vH - y);
+  if (w <= 0 || h <= 0) return;
+  uint32_t *row = getPixels() + x + y * vW;
+  for (int j = 0; j < h; j++, row += vW) for (int i = 0; i < w; i++) row[i] = c;
+}
+
+void Segment::getRow(int y, uint32_t *buf) const {
+  if (!isActive() || unsigned(y) >= vHeight()) return;
+  memcpy(buf, getPixels() + y * vWidth(), vWidth() * sizeof(uint32_t));
+}
+
+void Segment::setRow(int y, const uint32_t *buf) const {
+  if (!isActive() || unsigned(y) >= vHeight()) return;
+  memcpy(getPixels() + y * vWidth(), buf, vWidth() * sizeof(uint32_t));
+}
+
+void Segment::getColumn(int x, uint32_t *buf) const {
+  if (!isActive() || unsigned(x) >= vWidth()) return;
+  const unsigned vW = vWidth();
+  const uint32_t *px = getPixels() + x;
+  for (unsigned y = 0; y < vHeight(); y++, px += vW) buf[y] = *px;
+}
+
+void Segment::setColumn(int x, const uint32_t *buf) const {
+  if (!isActive() || unsigned(x) >= vWidth()) return;
+  const unsigned vW = vWidth();
+  uint32_t *px = getPixels() + x;
+  for (unsigned y = 0; y < vHeight(); y++, px += vW) *px = buf[y];
+}
+
 void Segment::moveX(int delta, bool wrap) const {
   if (!isActive() || !delta) return; // not active
   const int vW = vWidth();   // segment width in logical pixels (can be 0 if segment is inactive)
@@ -208,6 +208,7 @@ void Segment::resetIfRequired() {
   if (data && _dataLen > 0) memset(data, 0, _dataLen);  // prevent heap fragmentation (just erase buffer instead of deallocateData())
   if (pixels) for (size_t i = 0; i < length(); i++) pixels[i] = BLACK; // clear pixel buffer
   next_time = 0; step = 0; call = 0; aux0 = 0; aux1 = 0;
+  _budget = 0;
   reset = false;
   #ifdef WLED_ENABLE_GIF
   endImagePlayback(this);
@@ -520,7 +521,7 @@ Segment &Segment::setOption(uint8_t n, bool val) {
 
 Segment &Segment::setMode(uint8_t fx, bool loadDefaults) {
   // skip reserved
-  while (fx < strip.getModeCount() && strncmp_P("RSVD", strip.getModeData(fx), 4) == 0) fx++;
+  while (fx < strip.getModeCount() && (strip.getModeMeta(fx).flags & FX_META_RESERVED)) fx++;
   if (fx >= strip.getModeCount()) fx = 0; // set solid mode
   // if we have a valid mode & is not reserved
   if (fx != mode) {
@@ -1024,15 +1025,78 @@ void Segment::fade_out(uint8_t rate) const {
 // fades all pixels to secondary color
 void Segment::fadeToSecondaryBy(uint8_t fadeBy) const {
   if (!isActive() || fadeBy == 0) return;   // optimization - no scaling to apply
-  const size_t rlength = rawLength();  // calculate only once
-  for (unsigned i = 0; i < rlength; i++) setPixelColorRaw(i, color_blend(getPixelColorRaw(i), colors[1], fadeBy));
+  blendPixels(getPixels(), rawLength(), colors[1], fadeBy);
 }
 
 // fades all pixels to black using nscale8()
 void Segment::fadeToBlackBy(uint8_t fadeBy) const {
   if (!isActive() || fadeBy == 0) return;   // optimization - no scaling to apply
-  const size_t rlength = rawLength();  // calculate only once
-  for (unsigned i = 0; i < rlength; i++) setPixelColorRaw(i, color_fade(getPixelColorRaw(i), 255-fadeBy));
+  fadePixels(getPixels(), rawLength(), 255-fadeBy);
+}
+
+/*
+ * span functions: operate on pixels [start, start+len) of the virtual strip
+ * if virtual pixels map 1:1 onto the segment buffer (1D segment or 2D segment using "Pixels" mapping)
+ * the buffer is accessed directly, otherwise (1D effect expanded into 2D) pixels are set one by one
+ */
+bool Segment::clipRange(int &start, int &len) const {
+  if (!isActive()) return false;
+  const int vL = vLength();
+  if (start < 0) { len += start; start = 0; }
+  if (len > vL - start) len = vL - start;
+  return len > 0;
+}
+
+void Segment::fillRange(int start, int len, uint32_t c) const {
+  if (!clipRange(start, len)) return;
+  if (isLinear()) {
+    uint32_t *px = getPixels() + start;
+    for (int i = 0; i < len; i++) px[i] = c;
+  } else for (int i = start; i < start + len; i++) setPixelColor(i, c);
+}
+
+void Segment::fadeRange(int start, int len, uint8_t fadeBy) const {
+  if (fadeBy == 0 || !clipRange(start, len)) return;
+  const uint8_t scale = 255 - fadeBy;
+  if (isLinear()) fadePixels(getPixels() + start, len, scale);
+  else for (int i = start; i < start + len; i++) setPixelColor(i, color_fade(getPixelColor(i), scale));
+}
+
+void Segment::blendRange(int start, int len, uint32_t c, uint8_t blend) const {
+  if (blend == 0 || !clipRange(start, len)) return;
+  if (isLinear()) blendPixels(getPixels() + start, len, c, blend);
+  else for (int i = start; i < start + len; i++) setPixelColor(i, color_blend(getPixelColor(i), c, blend));
+}
+
+void Segment::addRange(int start, int len, uint32_t c, bool preserveCR) const {
+  if (c == BLACK || !clipRange(start, len)) return;
+  if (isLinear()) addPixels(getPixels() + start, len, c, preserveCR);
+  else for (int i = start; i < start + len; i++) setPixelColor(i, color_add(getPixelColor(i), c, preserveCR));
+}
+
+void Segment::copyRange(int dst, int src, int len) const {
+  if (!isActive() || dst == src || len <= 0) return;
+  const int vL = vLength();
+  // clip both ranges by the same amount so pixels keep their relative offset
+  const int lo = min(dst, src);
+  if (lo < 0) { dst -= lo; src -= lo; len += lo; }
+  len = min(len, vL - max(dst, src));
+  if (len <= 0) return;
+  if (isLinear()) memmove(getPixels() + dst, getPixels() + src, len * sizeof(uint32_t));
+  else if (dst < src) for (int i = 0; i < len; i++)    setPixelColor(dst + i, getPixelColor(src + i));
+  else                for (int i = len - 1; i >= 0; i--) setPixelColor(dst + i, getPixelColor(src + i));
+}
+
+void Segment::shiftRange(int start, int len, int delta, uint32_t c) const {
+  if (!clipRange(start, len) || delta == 0) return;
+  if (abs(delta) >= len) { fillRange(start, len, c); return; }
+  if (delta > 0) {
+    copyRange(start + delta, start, len - delta);
+    fillRange(start, delta, c);
+  } else {
+    copyRange(start, start - delta, len + delta);
+    fillRange(start + len + delta, -delta, c);
+  }
 }
 
 /*
@@ -1049,28 +1113,7 @@ void Segment::blur(uint8_t blur_amount, bool smear) const {
     return;
   }
 #endif
-  uint8_t keep = smear ? 255 : 255 - blur_amount;
-  uint8_t seep = blur_amount >> 1;
-  unsigned vlength = vLength();
-  uint32_t carryover = BLACK;
-  uint32_t lastnew; // not necessary to initialize lastnew and last, as both will be initialized by the first loop iteration
-  uint32_t last;
-  uint32_t curnew = BLACK;
-  for (unsigned i = 0; i < vlength; i++) {
-    uint32_t cur = getPixelColorRaw(i);
-    uint32_t part = color_fade(cur, seep);
-    curnew = color_fade(cur, keep);
-    if (i > 0) {
-      if (carryover) curnew = color_add(curnew, carryover);
-      uint32_t prev = color_add(lastnew, part);
-      // optimization: only set pixel if color has changed
-      if (last != prev) setPixelColorRaw(i - 1, prev);
-    } else setPixelColorRaw(i, curnew); // first pixel
-    lastnew = curnew;
-    last = cur; // save original value for comparison on next iteration
-    carryover = part;
-  }
-  setPixelColorRaw(vlength - 1, curnew);
+  blurPixelLine(pixels, vLength(), blur_amount, smear);
 }
 
 /*
@@ -1205,9 +1248,13 @@ void WS2812FX::finalizeInit() {
 
   //segments are created in makeAutoSegments();
   DEBUG_PRINTLN(F("Loading custom palettes"));
+  unsigned long phaseStart = millis();
   loadCustomPalettes(); // (re)load all custom palettes
+  bootPhaseDone(BOOT_PHASE_PALETTES, phaseStart);
   DEBUG_PRINTLN(F("Loading custom ledmaps"));
+  phaseStart = millis();
   deserializeMap();     // (re)load default ledmap (will also setUpMatrix() if ledmap does not exist)
+  bootPhaseDone(BOOT_PHASE_LEDMAP, phaseStart);
 
   // allocate frame buffer after matrix has been set up (gaps!)
   if (_pixels) d_free(_pixels); // using realloc on large buffers can cause additional fragmentation instead of reducing it
@@ -1643,13 +1690,18 @@ void WS2812FX::show() {
   int oldCCT = Bus::getCCT(); // store original CCT value (since it is global)
   // when cctFromRgb is true we implicitly calculate WW and CW from RGB values (cct==-1)
   if (cctFromRgb) BusManager::setSegmentCCT(-1);
-  for (size_t i = 0; i < totalLen; i++) {
-    // when correctWB is true setSegmentCCT() will convert CCT into K with which we can then
-    // correct/adjust RGB value according to desired CCT value, it will still affect actual WW/CW ratio
-    if (_pixelCCT) { // cctFromRgb already exluded at allocation
-      if (i == 0 || _pixelCCT[i-1] != _pixelCCT[i]) BusManager::setSegmentCCT(_pixelCCT[i], correctWB);
+  for (size_t i = 0; i < totalLen;) {
+    unsigned len;
+    int stride;
+    unsigned index = getMappedSpan(i, len, stride); // mapped pixels are processed in runs with constant stride
+    for (size_t end = min(i + len, totalLen); i < end; i++, index += stride) {
+      // when correctWB is true setSegmentCCT() will convert CCT into K with which we can then
+      // correct/adjust RGB value according to desired CCT value, it will still affect actual WW/CW ratio
+      if (_pixelCCT) { // cctFromRgb already exluded at allocation
+        if (i == 0 || _pixelCCT[i-1] != _pixelCCT[i]) BusManager::setSegmentCCT(_pixelCCT[i], correctWB);
+      }
+      BusManager::setPixelColor(index, realtimeMode && arlsDisableGammaCorrection ? _pixels[i] : gamma32(_pixels[i]));
     }
-    BusManager::setPixelColor(getMappedPixelIndex(i), realtimeMode && arlsDisableGammaCorrection ? _pixels[i] : gamma32(_pixels[i]));
   }
   Bus::setCCT(oldCCT);  // restore old CCT for ABL adjustments
 
@@ -1960,23 +2012,73 @@ void WS2812FX::printSize() {
   for (const Segment &seg : _segments) DEBUG_PRINTF_P(PSTR("  Seg: %d,%d [A=%d, 2D=%d, RGB=%d, W=%d, CCT=%d]\n"), seg.width(), seg.height(), seg.isActive(), seg.is2D(), seg.hasRGB(), seg.hasWhite(), seg.isCCT());
   DEBUG_PRINTF_P(PSTR("Modes: %d*%d=%uB\n"), sizeof(mode_ptr), _mode.size(), (_mode.capacity()*sizeof(mode_ptr)));
   DEBUG_PRINTF_P(PSTR("Data: %d*%d=%uB\n"), sizeof(const char *), _modeData.size(), (_modeData.capacity()*sizeof(const char *)));
-  DEBUG_PRINTF_P(PSTR("Map: %d*%d=%uB\n"), sizeof(uint16_t), (int)customMappingSize, customMappingSize*sizeof(uint16_t));
+  if (customMappingTable) DEBUG_PRINTF_P(PSTR("Map: %d*%d=%uB\n"), sizeof(uint16_t), (int)customMappingSize, customMappingSize*sizeof(uint16_t));
+  else                    DEBUG_PRINTF_P(PSTR("Map: %d*%d runs for %d\n"), sizeof(ledmap_run_t), (int)customMappingRunCount, (int)customMappingSize);
 }
 #endif
 
-// load custom mapping table from JSON file (called from finalizeInit() or deserializeState())
+// load custom mapping table from binary file
+bool WS2812FX::deserializeBinaryMap(File &f, unsigned n) {
+  ledmap_header_t hdr;
+  if (f.read((uint8_t*)&hdr, sizeof(hdr)) != sizeof(hdr) || hdr.magic != LEDMAP_BIN_MAGIC || hdr.version != LEDMAP_BIN_VERSION) {
+    DEBUG_PRINTLN(F("ERROR Invalid binary ledmap."));
+    return false;
+  }
+  DEBUG_PRINTF_P(PSTR("Reading binary LED map %u (%u entries)\n"), n, (unsigned)hdr.count);
+
+  suspend();
+  waitForIt();
+
+  // if we are loading default ledmap (at boot) set matrix width and height from the ledmap
+  if (n == 0 && (hdr.width || hdr.height)) {
+    Segment::maxWidth  = min(max((int)hdr.width, 1), 255);
+    Segment::maxHeight = min(max((int)hdr.height, 1), 255);
+    isMatrix = true;
+  }
+
+  freeMapping();
+  customMappingTable = static_cast<uint16_t*>(d_malloc(sizeof(uint16_t)*getLengthTotal())); // do not use SPI RAM
+  if (customMappingTable) {
+    size_t count = min((unsigned)hdr.count, (unsigned)getLengthTotal());
+    // entries are stored in native (little endian) byte order so they can be read directly into the table
+    if (f.read((uint8_t*)customMappingTable, count * sizeof(uint16_t)) == count * sizeof(uint16_t)) {
+      customMappingSize = count;
+      currentLedmap = n;
+      compactMapping();
+    }
+  } else {
+    DEBUG_PRINTLN(F("ERROR LED map allocation error."));
+  }
+
+  resume();
+  return (customMappingSize > 0);
+}
+
+// load custom mapping table from binary or JSON file (called from finalizeInit() or deserializeState())
 // if this is a matrix set-up and default ledmap.json file does not exist, create mapping table using setUpMatrix() from panel information
 bool WS2812FX::deserializeMap(unsigned n) {
   char fileName[32];
   strcpy_P(fileName, PSTR("/ledmap"));
   if (n) sprintf(fileName +7, "%d", n);
-  strcat_P(fileName, PSTR(".json"));
-  bool isFile = WLED_FS.exists(fileName);
+  char *ext = fileName + strlen(fileName);
+  strcpy_P(ext, PSTR(".bin"));
+  bool isBinary = WLED_FS.exists(fileName);
+  if (!isBinary) strcpy_P(ext, PSTR(".json"));
+  bool isFile = isBinary || WLED_FS.exists(fileName);
 
   customMappingSize = 0; // prevent use of mapping if anything goes wrong
   currentLedmap = 0;
   if (n == 0 || isFile) interfaceUpdateCallMode = CALL_MODE_WS_SEND; // schedule WS update (to inform UI)
 
+  if (isBinary) {
+    File f = WLED_FS.open(fileName, "r");
+    bool loaded = f && deserializeBinaryMap(f, n);
+    f.close();
+    if (loaded || n) return loaded;
+    strcpy_P(ext, PSTR(".json")); // fall back to JSON if default binary ledmap is invalid
+    isFile = WLED_FS.exists(fileName);
+  }
+
   if (!isFile && n==0 && isMatrix) {
     // 2D panel support creates its own ledmap (on the fly) if a ledmap.json does not exist
     setUpMatrix();
@@ -2006,7 +2108,7 @@ bool WS2812FX::deserializeMap(unsigned n) {
     isMatrix = true;
   }
 
-  d_free(customMappingTable);
+  freeMapping();
   customMappingTable = static_cast<uint16_t*>(d_malloc(sizeof(uint16_t)*getLengthTotal())); // do not use SPI RAM
 
   if (customMappingTable) {
@@ -2043,6 +2145,7 @@ bool WS2812FX::deserializeMap(unsigned n) {
     }
     DEBUG_PRINTLN();
     #endif
+    compactMapping();
 /*
     JsonArray map = root[F("map")];
     if (!map.isNull() && map.size()) {  // not an empty map
@@ -2062,6 +2165,130 @@ bool WS2812FX::deserializeMap(unsigned n) {
 }
 
 
+void WS2812FX::freeMapping() {
+  d_free(customMappingTable);
+  d_free(customMappingRuns);
+  customMappingTable = nullptr;
+  customMappingRuns = nullptr;
+  customMappingRunCount = 0;
+  _mapRunHint = 0;
+}
+
+// converts customMappingTable into runs of pixels with constant stride (missing pixels and pixels that do not form
+// a long enough run are stored as explicit entries) if that needs less RAM
+// matrix ledmaps (serpentine, rotated, with gaps) typically need a few bytes per row instead of 2 bytes per pixel
+void WS2812FX::compactMapping() {
+  if (!customMappingTable || customMappingSize == 0) return;
+  const uint16_t *map = customMappingTable;
+  const unsigned size = customMappingSize;
+
+  // length of run starting at i (and its stride)
+  auto runAt = [map, size](unsigned i, int &stride) -> unsigned {
+    unsigned len = 1;
+    stride = 1;
+    if (map[i] == 0xFFFF) {
+      stride = 0;
+      while (i + len < size && map[i + len] == 0xFFFF) len++;
+    } else if (i + 1 < size && map[i + 1] != 0xFFFF) {
+      stride = (int)map[i + 1] - (int)map[i];
+      if (stride <= LEDMAP_EXPLICIT || stride > INT16_MAX) return 1;
+      while (i + len < size && map[i + len] != 0xFFFF && (int)map[i + len] - (int)map[i + len - 1] == stride) len++;
+    }
+    return len;
+  };
+
+  // 1st pass counts runs and explicit entries, 2nd pass fills them
+  unsigned runs = 0, entries = 0;
+  ledmap_run_t *run = nullptr;
+  for (unsigned pass = 0; pass < 2; pass++) {
+    uint16_t *explicitEntries = run ? reinterpret_cast<uint16_t*>(run + runs) : nullptr;
+    runs = entries = 0;
+    for (unsigned i = 0; i < size;) {
+      int stride;
+      unsigned len = runAt(i, stride);
+      if (len >= LEDMAP_MIN_RUN) {
+        if (run) run[runs] = {uint16_t(i), map[i], int16_t(stride)};
+        i += len;
+      } else {
+        unsigned start = i;
+        do i += len; while (i < size && (len = runAt(i, stride)) < LEDMAP_MIN_RUN);
+        if (run) {
+          run[runs] = {uint16_t(start), uint16_t(entries), LEDMAP_EXPLICIT};
+          memcpy(explicitEntries + entries, map + start, (i - start) * sizeof(uint16_t));
+        }
+        entries += i - start;
+      }
+      runs++;
+    }
+    if (pass == 0) {
+      size_t bytes = runs * sizeof(ledmap_run_t) + entries * sizeof(uint16_t);
+      if (bytes >= size * sizeof(uint16_t)) return; // table is smaller
+      run = static_cast<ledmap_run_t*>(d_malloc(bytes)); // do not use SPI RAM
+      if (!run) return;
+    }
+  }
+  d_free(customMappingTable);
+  customMappingTable = nullptr;
+  customMappingRuns = run;
+  customMappingRunCount = runs;
+  _mapRunHint = 0;
+  DEBUG_PRINTF_P(PSTR("ledmap compacted: %u runs, %u explicit entries (%uB)\n"), runs, entries, runs * sizeof(ledmap_run_t) + entries * sizeof(uint16_t));
+}
+
+// index of run containing logical pixel (index < customMappingSize)
+unsigned WS2812FX::findMappingRun(unsigned index) const {
+  const ledmap_run_t *run = customMappingRuns;
+  unsigned r = _mapRunHint;
+  if (r < customMappingRunCount && run[r].start <= index) {
+    // pixels are mostly accessed sequentially: check last used and next run first
+    if (r + 1 == customMappingRunCount || run[r + 1].start > index) return r;
+    if (r + 2 == customMappingRunCount || run[r + 2].start > index) return _mapRunHint = r + 1;
+  }
+  unsigned lo = 0, hi = customMappingRunCount; // last run with start <= index
+  while (hi - lo > 1) {
+    unsigned mid = (lo + hi) / 2;
+    if (run[mid].start <= index) lo = mid;
+    else                         hi = mid;
+  }
+  return _mapRunHint = lo;
+}
+
+uint16_t WS2812FX::getMappedRunIndex(unsigned index) const {
+  const ledmap_run_t &run = customMappingRuns[findMappingRun(index)];
+  unsigned offset = index - run.start;
+  if (run.stride == LEDMAP_EXPLICIT) return reinterpret_cast<const uint16_t*>(customMappingRuns + customMappingRunCount)[run.target + offset];
+  if (run.target == 0xFFFF) return 0xFFFF;
+  return run.target + (int)offset * run.stride;
+}
+
+// returns physical address of logical pixel and sets len to the number of pixels (starting with index) whose
+// physical addresses increase by stride (used by show() to process mapped pixels in bulk)
+uint16_t WS2812FX::getMappedSpan(unsigned index, unsigned &len, int &stride) const {
+  unsigned total = getLengthTotal();
+  len = index < total ? total - index : 1;
+  stride = 1;
+  if (index >= customMappingSize || !(realtimeMode == REALTIME_MODE_INACTIVE || realtimeRespectLedMaps)) return index;
+  if (customMappingTable) {
+    len = 1;
+    return customMappingTable[index];
+  }
+  unsigned r = findMappingRun(index);
+  const ledmap_run_t &run = customMappingRuns[r];
+  unsigned end = r + 1 < customMappingRunCount ? customMappingRuns[r + 1].start : customMappingSize;
+  len = end - index;
+  if (run.stride == LEDMAP_EXPLICIT) {
+    len = 1;
+    return reinterpret_cast<const uint16_t*>(customMappingRuns + customMappingRunCount)[run.target + index - run.start];
+  }
+  if (run.target == 0xFFFF) {
+    stride = 0;
+    return 0xFFFF;
+  }
+  stride = run.stride;
+  return run.target + (int)(index - run.start) * run.stride;
+}
+
+
 const char JSON_mode_names[] PROGMEM = R"=====(["FX names moved"])=====";
 const char JSON_palette_names[] PROGMEM = R"=====([
 "Default","* Random Cycle","* Color 1","* Colors 1&2","* Color Gradient","* Colors Only","Party","Cloud","Lava","Ocean",
@@ -19,6 +19,85 @@ static int32_t calcForce_dv(const int8_t force, uint8_t &counter);
 static bool checkBoundsAndWrap(int32_t &position, const int32_t max, const int32_t particleradius, const bool wrap); // returns false if out of bounds by more than particleradius
 static uint32_t fast_color_add(CRGBW c1, const CRGBW c2, uint8_t scale = 255); // fast and accurate color adding with scaling (scales c2 before adding)
 static uint32_t fast_color_scale(CRGBW c, const uint8_t scale); // fast scaling function using 32bit variable and pointer. note: keep 'scale' within 0-255
+
+// per frame particle color cache, reset at the beginning of render()
+// palette colors are looked up once per frame and index, desaturated colors are kept in a small direct mapped cache to avoid the rgb->hsv->rgb round trip
+// note: 1444 bytes, kept in the segment data of each particle system (one per render thread in 2D) so it only uses RAM while a PS effect runs
+#define PS_DESAT_CACHE 64 // number of cached desaturated colors, must be a power of 2
+class PSColorCache {
+public:
+  void reset(const TBlendType blend) {
+    blendType = blend;
+    memset(valid, 0, sizeof(valid));
+    memset(desatKey, 0xFF, sizeof(desatKey)); // 0xFFFF is never used as a key (saturation is < 255)
+  }
+  uint32_t color(const uint8_t index) {
+    if (!(valid[index >> 5] & (1U << (index & 31)))) {
+      palette[index] = ColorFromPaletteWLED(SEGPALETTE, index, 255, blendType);
+      valid[index >> 5] |= 1U << (index & 31);
+    }
+    return palette[index];
+  }
+  uint32_t color(const uint8_t index, const uint8_t sat) {
+    if (sat == 255) return color(index);
+    const uint16_t key = (index << 8) | sat;
+    const uint32_t slot = (index + sat * 7) & (PS_DESAT_CACHE - 1);
+    if (desatKey[slot] != key) {
+      CHSV32 baseHSV;
+      rgb2hsv(color(index), baseHSV); // convert to HSV
+      baseHSV.s = min(baseHSV.s, sat); // set the saturation but don't increase it
+      hsv2rgb(baseHSV, desatColor[slot]); // convert back to RGB
+      desatKey[slot] = key;
+    }
+    return desatColor[slot];
+  }
+private:
+  uint32_t palette[256];
+  uint32_t valid[256 / 32]; // one bit per palette entry
+  uint32_t desatColor[PS_DESAT_CACHE];
+  uint16_t desatKey[PS_DESAT_CACHE]; // palette index << 8 | saturation
+  TBlendType blendType;
+};
+static_assert(sizeof(PSColorCache) % 4 == 0, "PSColorCache must keep the segment data following it 4 byte aligned");
+#endif
+
+#if defined(WLED_PS_DUALCORE) && !defined(WLED_DISABLE_PARTICLESYSTEM2D)
+// second core worker: runs part 1 of a job on the other core while the calling task runs part 0
+typedef void (*PSjob)(void *context, const uint32_t part);
+static PSjob psWorkerJob = nullptr;
+static void *psWorkerContext = nullptr;
+
+static TaskHandle_t psWorkerTask = nullptr;
+static SemaphoreHandle_t psJobReady = nullptr; // given by the caller when a job is set
+static SemaphoreHandle_t psJobDone = nullptr;  // given by the worker when part 1 is done (not a task notification, the loop task may get others)
+
+static void psWorker(void *) {
+  for (;;) {
+    xSemaphoreTake(psJobReady, portMAX_DELAY); // wait for a job
+    psWorkerJob(psWorkerContext, 1);
+    xSemaphoreGive(psJobDone); // signal completion
+  }
+}
+
+// run both parts of a job in parallel, returns when both are done. jobs must not write to shared data (other than their own part)
+static void runOnBothCores(PSjob job, void *context) {
+  if (psWorkerTask == nullptr) {
+    if (!psJobReady) psJobReady = xSemaphoreCreateBinary();
+    if (!psJobDone)  psJobDone  = xSemaphoreCreateBinary();
+    if (psJobReady && psJobDone)
+      xTaskCreatePinnedToCore(psWorker, "PSworker", 4096, nullptr, uxTaskPriorityGet(nullptr), &psWorkerTask, xPortGetCoreID() ? 0 : 1); // pin to the other core
+    if (psWorkerTask == nullptr) { // could not create worker task, run serially
+      job(context, 0);
+      job(context, 1);
+      return;
+    }
+  }
+  psWorkerJob = job;
+  psWorkerContext = context;
+  xSemaphoreGive(psJobReady);
+  job(context, 0);
+  xSemaphoreTake(psJobDone, portMAX_DELAY); // wait for worker
+}
 #endif
 
 #ifndef WLED_DISABLE_PARTICLESYSTEM2D
@@ -27,6 +106,10 @@ ParticleSystem2D::ParticleSystem2D(uint32_t width, uint32_t height, uint32_t num
   numSources = numberofsources; // number of sources allocated in init
   numParticles = numberofparticles; // number of particles allocated in init
   usedParticles = numParticles; // use all particles by default
+  requestedParticles = numParticles;
+  particleBudget = 255; // full budget, reduced by updateBudget() if frame rate cannot be held
+  budgetCounter = 0;
+  workTime = 0;
   advPartProps = nullptr; //make sure we start out with null pointers (just in case memory was not cleared)
   advPartSize = nullptr;
   setMatrixSize(width, height);
@@ -38,7 +121,6 @@ ParticleSystem2D::ParticleSystem2D(uint32_t width, uint32_t height, uint32_t num
   motionBlur = 0; //no fading by default
   smearBlur = 0; //no smearing by default
   emitIndex = 0;
-  collisionStartIdx = 0;
 
   //initialize some default non-zero values most FX use
   for (uint32_t i = 0; i < numParticles; i++) {
@@ -54,6 +136,7 @@ ParticleSystem2D::ParticleSystem2D(uint32_t width, uint32_t height, uint32_t num
 
 // update function applies gravity, moves the particles, handles collisions and renders the particles
 void ParticleSystem2D::update(void) {
+  uint32_t startTime = micros();
   //apply gravity globally if enabled
   if (particlesettings.useGravity)
     applyGravity();
@@ -72,24 +155,61 @@ void ParticleSystem2D::update(void) {
     handleCollisions();
 
   //move all particles
-  for (uint32_t i = 0; i < usedParticles; i++) {
-    particleMoveUpdate(particles[i], particleFlags[i], nullptr, advPartProps ? &advPartProps[i] : nullptr); // note: splitting this into two loops is slower and uses more flash
-  }
+  moveParticles();
 
   render();
+  updateBudget(micros() - startTime);
 }
 
 // update function for fire animation
 void ParticleSystem2D::updateFire(const uint8_t intensity,const bool renderonly) {
+  uint32_t startTime = micros();
   if (!renderonly)
     fireParticleupdate();
   fireIntesity = intensity > 0 ? intensity : 1; // minimum of 1, zero checking is used in render function
   render();
+  if (!renderonly)
+    updateBudget(micros() - startTime);
+}
+
+// adaptive particle budget: scales the number of used particles so the PS work (update and render) fits into the target frame time
+// the budget is reduced quickly if the PS uses more than 3/4 of the frame time and slowly increased if it uses less than half of it, keeping the rest for FX code and other segments
+// note: with unlimited FPS there is no target, the full budget is used
+void ParticleSystem2D::updateBudget(const uint32_t elapsed) {
+  workTime = workTime ? (workTime * 7 + elapsed) >> 3 : elapsed; // smoothed work time in us
+  uint32_t frameTime = strip.getTargetFps() ? strip.getFrameTime() * 1000 : 0; // target frame time in us
+  uint32_t budget = particleBudget;
+  if (frameTime == 0)
+    budget = 255;
+  else if (++budgetCounter >= 8) { // adjust every 8 frames so the smoothed work time can follow
+    budgetCounter = 0;
+    if (workTime > (frameTime * 3) >> 2)
+      budget = max(budget - (budget >> 3) - 1, (uint32_t)PS_MIN_BUDGET); // reduce by 1/8
+    else if (workTime < frameTime >> 1)
+      budget = min(budget + 4, (uint32_t)255);
+  }
+  if (budget != particleBudget) {
+    particleBudget = budget;
+    applyBudget();
+  }
+  SEGMENT.setBudget(particleBudget); // report to segment state
+}
+
+// set used particles from requested particles and current budget, particles that are no longer used are killed
+void ParticleSystem2D::applyBudget() {
+  uint32_t oldUsed = usedParticles;
+  usedParticles = (requestedParticles * (particleBudget + 1)) >> 8;
+  if (usedParticles == 0 && requestedParticles > 0)
+    usedParticles = 1;
+  for (uint32_t i = usedParticles; i < oldUsed; i++)
+    particles[i].ttl = 0; // kill unused particles so they do not reappear frozen in place if the budget increases
 }
 
 // set percentage of used particles as uint8_t i.e 127 means 50% for example
+// note: the actual number of used particles is also scaled by the adaptive particle budget
 void ParticleSystem2D::setUsedParticles(uint8_t percentage) {
-  usedParticles = (numParticles * ((int)percentage+1)) >> 8; // number of particles to use (percentage is 0-255, 255 = 100%)
+  requestedParticles = (numParticles * ((int)percentage+1)) >> 8; // number of particles to use (percentage is 0-255, 255 = 100%)
+  applyBudget();
   PSPRINT(" SetUsedpaticles: allocated particles: ");
   PSPRINT(numParticles);
   PSPRINT(" ,used particles: ");
@@ -223,13 +343,68 @@ int32_t ParticleSystem2D::angleEmit(PSsource &emitter, const uint16_t angle, con
 // particle moves, decays and dies, if killoutofbounds is set, out of bounds particles are set to ttl=0
 // uses passed settings to set bounce or wrap, if useGravity is enabled, it will never bounce at the top and killoutofbounds is not applied over the top
 void ParticleSystem2D::particleMoveUpdate(PSparticle &part, PSparticleFlags &partFlags, PSsettings2D *options, PSadvancedParticle *advancedproperties) {
-  if (options == nullptr)
-    options = &particlesettings; //use PS system settings by default
+  moveParticle(part, partFlags, options ? *options : particlesettings, advancedproperties); // use PS system settings by default
+}
+
+// move all used particles in one pass
+// settings are copied to a local variable: writes to particles may alias the settings byte, forcing the compiler to reload them for every particle
+void ParticleSystem2D::moveParticles() {
+  #ifdef WLED_PS_DUALCORE
+  if (!advPartProps && usedParticles >= PS_DUALCORE_MINPARTICLES) { // note: advanced particles update particleHardRadius while moving and cannot be split
+    runOnBothCores(moveJob, this);
+    return;
+  }
+  #endif
+  const PSsettings2D options = particlesettings;
+  for (uint32_t i = 0; i < usedParticles; i++) {
+    moveParticle(particles[i], particleFlags[i], options, advPartProps ? &advPartProps[i] : nullptr); // note: splitting this into two loops is slower and uses more flash
+  }
+}
+
+#ifdef WLED_PS_DUALCORE
+// dual core move job: each part moves one half of the particles
+void ParticleSystem2D::moveJob(void *context, const uint32_t part) {
+  ParticleSystem2D *PartSys = static_cast<ParticleSystem2D *>(context);
+  const PSsettings2D options = PartSys->particlesettings;
+  const uint32_t half = PartSys->usedParticles >> 1;
+  const uint32_t end = part ? PartSys->usedParticles : half;
+  for (uint32_t i = part ? half : 0; i < end; i++)
+    PartSys->moveParticle(PartSys->particles[i], PartSys->particleFlags[i], options, nullptr);
+}
+
+// dual core render job: each part renders one half of the frame buffer rows
+void ParticleSystem2D::renderJob(void *context, const uint32_t part) {
+  ParticleSystem2D *PartSys = static_cast<ParticleSystem2D *>(context);
+  const int32_t half = (PartSys->maxYpixel + 1) >> 1;
+  if (part) PartSys->renderParticles(half, PartSys->maxYpixel, 1);
+  else      PartSys->renderParticles(0, half - 1, 0);
+}
+
+// collision grid passed to the dual core collision job
+struct PScollisionGrid {
+  ParticleSystem2D *PartSys;
+  const uint16_t *cellCount;
+  const uint16_t *sortedIdx;
+  uint32_t gridW;
+  uint32_t gridH;
+  uint32_t collDistSq;
+};
+
+// dual core collision job: part 0 checks the cell rows below the seam row, part 1 the rows above it (see handleCollisions())
+void ParticleSystem2D::collisionJob(void *context, const uint32_t part) {
+  const PScollisionGrid *grid = static_cast<const PScollisionGrid *>(context);
+  const uint32_t seam = (grid->gridH >> 1) - 1;
+  if (part) grid->PartSys->collideCellRows(grid->cellCount, grid->sortedIdx, grid->gridW, grid->gridH, seam + 1, grid->gridH, grid->collDistSq);
+  else      grid->PartSys->collideCellRows(grid->cellCount, grid->sortedIdx, grid->gridW, grid->gridH, 0, seam, grid->collDistSq);
+}
+#endif
 
+// move a particle: apply velocity, handle walls and bounds
+inline void ParticleSystem2D::moveParticle(PSparticle &part, PSparticleFlags &partFlags, const PSsettings2D &options, PSadvancedParticle *advancedproperties) {
   if (part.ttl > 0) {
     if (!partFlags.perpetual)
       part.ttl--; // age
-    if (options->colorByAge)
+    if (options.colorByAge)
       part.hue = min(part.ttl, (uint16_t)255); //set color to ttl
 
     int32_t renderradius = PS_P_HALFRADIUS; // used to check out of bounds
@@ -245,30 +420,30 @@ void ParticleSystem2D::particleMoveUpdate(PSparticle &part, PSparticleFlags &par
       }
     }
     // note: if wall collisions are enabled, bounce them before they reach the edge, it looks much nicer if the particle does not go half out of view
-    if (options->bounceY) {
-      if ((newY < (int32_t)particleHardRadius) || ((newY > (int32_t)(maxY - particleHardRadius)) && !options->useGravity)) { // reached floor / ceiling
+    if (options.bounceY) {
+      if ((newY < (int32_t)particleHardRadius) || ((newY > (int32_t)(maxY - particleHardRadius)) && !options.useGravity)) { // reached floor / ceiling
          bounce(part.vy, part.vx, newY, maxY);
       }
     }
 
-    if (!checkBoundsAndWrap(newY, maxY, renderradius, options->wrapY)) { // check out of bounds  note: this must not be skipped. if gravity is enabled, particles will never bounce at the top
+    if (!checkBoundsAndWrap(newY, maxY, renderradius, options.wrapY)) { // check out of bounds  note: this must not be skipped. if gravity is enabled, particles will never bounce at the top
       partFlags.outofbounds = true;
-      if (options->killoutofbounds) {
+      if (options.killoutofbounds) {
         if (newY < 0) // if gravity is enabled, only kill particles below ground
           part.ttl = 0;
-        else if (!options->useGravity)
+        else if (!options.useGravity)
           part.ttl = 0;
       }
     }
 
     if (part.ttl) { //check x direction only if still alive
-      if (options->bounceX) {
+      if (options.bounceX) {
         if ((newX < (int32_t)particleHardRadius) || (newX > (int32_t)(maxX - particleHardRadius))) // reached a wall
           bounce(part.vx, part.vy, newX, maxX);
       }
-      else if (!checkBoundsAndWrap(newX, maxX, renderradius, options->wrapX)) { // check out of bounds
+      else if (!checkBoundsAndWrap(newX, maxX, renderradius, options.wrapX)) { // check out of bounds
         partFlags.outofbounds = true;
-        if (options->killoutofbounds)
+        if (options.killoutofbounds)
           part.ttl = 0;
       }
     }
@@ -435,14 +610,17 @@ void ParticleSystem2D::applyForce(const uint32_t particleindex, const int8_t xfo
 // apply a force in x,y direction to all particles
 // force is in 3.4 fixed point notation (see above)
 void ParticleSystem2D::applyForce(const int8_t xforce, const int8_t yforce) {
-  // for small forces, need to use a delay counter
-  uint8_t tempcounter;
-  // note: this is not the most computationally efficient way to do this, but it saves on duplicate code and is fast enough
+  // for small forces, need to use a delay counter: all particles share the global counter so the velocity change is the same for all of them
+  uint8_t xcounter = forcecounter & 0x0F; // lower four bits
+  uint8_t ycounter = forcecounter >> 4;   // upper four bits
+  int32_t dvx = calcForce_dv(xforce, xcounter);
+  int32_t dvy = calcForce_dv(yforce, ycounter);
+  forcecounter = (xcounter & 0x0F) | ((ycounter << 4) & 0xF0); // save values back
+  if (dvx == 0 && dvy == 0) return;
   for (uint32_t i = 0; i < usedParticles; i++) {
-    tempcounter = forcecounter;
-    applyForce(particles[i], xforce, yforce, tempcounter);
+    particles[i].vx = limitSpeed((int32_t)particles[i].vx + dvx);
+    particles[i].vy = limitSpeed((int32_t)particles[i].vy + dvy);
   }
-  forcecounter = tempcounter; // save value back
 }
 
 // apply a force in angular direction to single particle
@@ -561,13 +739,6 @@ void ParticleSystem2D::render() {
     PSPRINTLN(F("PS render: no framebuffer!"));
     return;
   }
-  CRGBW baseRGB;
-  uint32_t brightness; // particle brightness, fades if dying
-  TBlendType blend = LINEARBLEND; // default color rendering: wrap palette
-  if (particlesettings.colorByAge) {
-    blend = LINEARBLEND_NOWRAP;
-  }
-
   if (motionBlur) { // motion-blurring active
     for (int32_t y = 0; y <= maxYpixel; y++) {
       int index = y * (maxXpixel + 1);
@@ -582,28 +753,12 @@ void ParticleSystem2D::render() {
   }
 
   // go over particles and render them to the buffer
-  for (uint32_t i = 0; i < usedParticles; i++) {
-    if (particles[i].ttl == 0 || particleFlags[i].outofbounds)
-      continue;
-    // generate RGB values for particle
-    if (fireIntesity) { // fire mode
-      brightness = (uint32_t)particles[i].ttl * (3 + (fireIntesity >> 5)) + 5;
-      brightness = min(brightness, (uint32_t)255);
-      baseRGB = ColorFromPaletteWLED(SEGPALETTE, brightness, 255, LINEARBLEND_NOWRAP);
-    }
-    else {
-      brightness = min((particles[i].ttl << 1), (int)255);
-      baseRGB = ColorFromPaletteWLED(SEGPALETTE, particles[i].hue, 255, blend);
-      if (particles[i].sat < 255) {
-        CHSV32 baseHSV;
-        rgb2hsv(baseRGB.color32, baseHSV); // convert to HSV
-        baseHSV.s = min(baseHSV.s, particles[i].sat); // set the saturation but don't increase it
-        hsv2rgb(baseHSV, baseRGB.color32); // convert back to RGB
-      }
-    }
-    if(gammaCorrectBri) brightness = gamma8(brightness); // apply gamma correction, used for gamma-inverted brightness distribution
-    renderParticle(i, brightness, baseRGB, particlesettings.wrapX, particlesettings.wrapY);
-  }
+  #ifdef WLED_PS_DUALCORE
+  if (usedParticles >= PS_DUALCORE_MINPARTICLES && maxYpixel > 0)
+    runOnBothCores(renderJob, this);
+  else
+  #endif
+    renderParticles(0, maxYpixel, 0);
 
   // apply global size rendering
   if (particlesize > 1) {
@@ -624,8 +779,49 @@ void ParticleSystem2D::render() {
   }
 }
 
+// render all particles, only frame buffer rows yStart to yEnd (in PS coordinates, i.e. 0 is the bottom row) are written
+// rendering in row bands gives the same result as rendering the full frame, so bands can be rendered in parallel
+void ParticleSystem2D::renderParticles(const int32_t yStart, const int32_t yEnd, const uint32_t cacheIndex) {
+  PSColorCache &cache = colorCache[cacheIndex];
+  CRGBW baseRGB;
+  uint32_t brightness; // particle brightness, fades if dying
+  TBlendType blend = LINEARBLEND; // default color rendering: wrap palette
+  if (particlesettings.colorByAge || fireIntesity) {
+    blend = LINEARBLEND_NOWRAP;
+  }
+  const bool skipOutside = yStart > 0 || yEnd < maxYpixel; // rendering a band: particles that do not touch it are skipped, so each band only does the work for its own particles
+  const int32_t height = maxYpixel + 1;
+  cache.reset(blend);
+  for (uint32_t i = 0; i < usedParticles; i++) {
+    if (particles[i].ttl == 0 || particleFlags[i].outofbounds)
+      continue;
+    if (skipOutside) {
+      int32_t y = particles[i].y >> PS_P_RADIUS_SHIFT;
+      if (y + 6 < yStart || y - 6 > yEnd) { // note: largest rendered particle is 10x10 pixels
+        if (!particlesettings.wrapY)
+          continue;
+        y += (y < yStart) ? height : -height; // particle may wrap into the band from the other side
+        if (y + 6 < yStart || y - 6 > yEnd)
+          continue;
+      }
+    }
+    // generate RGB values for particle
+    if (fireIntesity) { // fire mode
+      brightness = (uint32_t)particles[i].ttl * (3 + (fireIntesity >> 5)) + 5;
+      brightness = min(brightness, (uint32_t)255);
+      baseRGB = cache.color(brightness);
+    }
+    else {
+      brightness = min((particles[i].ttl << 1), (int)255);
+      baseRGB = cache.color(particles[i].hue, particles[i].sat);
+    }
+    if(gammaCorrectBri) brightness = gamma8(brightness); // apply gamma correction, used for gamma-inverted brightness distribution
+    renderParticle(i, brightness, baseRGB, particlesettings.wrapX, particlesettings.wrapY, yStart, yEnd);
+  }
+}
+
 // calculate pixel positions and brightness distribution and render the particle to local buffer or global buffer
-__attribute__((optimize("O2"))) void ParticleSystem2D::renderParticle(const uint32_t particleindex, const uint8_t brightness, const CRGBW& color, const bool wrapX, const bool wrapY) {
+__attribute__((optimize("O2"))) void ParticleSystem2D::renderParticle(const uint32_t particleindex, const uint8_t brightness, const CRGBW& color, const bool wrapX, const bool wrapY, const int32_t yStart, const int32_t yEnd) {
   uint32_t size = particlesize;
   if (advPartProps && advPartProps[particleindex].size > 0) // use advanced size properties (0 means use global size including single pixel rendering)
     size = advPartProps[particleindex].size;
@@ -633,7 +829,7 @@ __attribute__((optimize("O2"))) void ParticleSystem2D::renderParticle(const uint
   if (size == 0) { // single pixel rendering
     uint32_t x = particles[particleindex].x >> PS_P_RADIUS_SHIFT;
     uint32_t y = particles[particleindex].y >> PS_P_RADIUS_SHIFT;
-    if (x <= (uint32_t)maxXpixel && y <= (uint32_t)maxYpixel) {
+    if (x <= (uint32_t)maxXpixel && (int32_t)y >= yStart && (int32_t)y <= yEnd) { // note: y is unsigned, negative values are out of the band
       uint32_t index = x + (maxYpixel - y) * (maxXpixel + 1); // flip y coordinate (0,0 is bottom left in PS but top left in framebuffer)
       framebuffer[index] = fast_color_add(framebuffer[index], color, brightness);
     }
@@ -747,6 +943,7 @@ __attribute__((optimize("O2"))) void ParticleSystem2D::renderParticle(const uint
           else
           continue;
         }
+        if ((int32_t)yfb < yStart || (int32_t)yfb > yEnd) continue; // row is rendered by another thread
         uint32_t idx = xfb + (maxYpixel - yfb) * (maxXpixel + 1); // flip y coordinate (0,0 is bottom left in PS but top left in framebuffer)
         framebuffer[idx] = fast_color_add(framebuffer[idx], renderbuffer[xrb + yrb * 10]);
       }
@@ -783,7 +980,7 @@ __attribute__((optimize("O2"))) void ParticleSystem2D::renderParticle(const uint
       }
     }
     for (uint32_t i = 0; i < 4; i++) {
-      if (pixelvalid[i]) {
+      if (pixelvalid[i] && pixco[i].y >= yStart && pixco[i].y <= yEnd) {
         uint32_t idx = pixco[i].x + (maxYpixel - pixco[i].y) * (maxXpixel + 1); // flip y coordinate (0,0 is bottom left in PS but top left in framebuffer)
         framebuffer[idx] = fast_color_add(framebuffer[idx], color, pxlbrightness[i]); // order is: bottom left, bottom right, top right, top left
       }
@@ -792,67 +989,119 @@ __attribute__((optimize("O2"))) void ParticleSystem2D::renderParticle(const uint
 }
 
 // detect collisions in an array of particles and handle them
-// uses binning by dividing the frame into slices in x direction which is efficient if using gravity in y direction (but less efficient for FX that use forces in x direction)
-// for code simplicity, no y slicing is done, making very tall matrix configurations less efficient
-// note: also tested adding y slicing, it gives diminishing returns, some FX even get slower. FX not using gravity would benefit with a 10% FPS improvement
+// uses a uniform grid as broadphase: particles are counting-sorted into square cells (at least one collision distance wide) once per frame,
+// then each particle is only checked against particles in its own cell and in the four "forward" neighbour cells (E, SW, S, SE) so every close pair is checked exactly once
+// cost is linear in the number of particles, the grid is coarsened on large matrices so it never has more cells than particles
+// length of the collision grid buffer: handleCollisions() uses at most max(particles, 16) cells plus one counter and one index per particle
+// numparticles is a multiple of 4, the +4 keeps the data following the grid 4 byte aligned
+static uint32_t collisionGridLength(const uint32_t numparticles) {
+  return max(numparticles, (uint32_t)16) + 4 + numparticles;
+}
+
 void ParticleSystem2D::handleCollisions() {
+  if (advPartProps) //may be using individual particle size
+    setParticleSize(particlesize); // updates base particleHardRadius (particleMoveUpdate() adds individual sizes)
   uint32_t collDistSq = particleHardRadius << 1; // distance is double the radius note: particleHardRadius is updated when setting global particle size
+  uint32_t maxCollDist = collDistSq;
+  if (advPartProps)
+    maxCollDist += 255; // add max individual size (see collision distance calculation below)
   collDistSq = collDistSq * collDistSq; // square it for faster comparison (square is one operation)
-  // note: partices are binned in x-axis, assumption is that no more than half of the particles are in the same bin
-  // if they are, collisionStartIdx is increased so each particle collides at least every second frame (which still gives decent collisions)
-  constexpr int BIN_WIDTH = 6 * PS_P_RADIUS; // width of a bin in sub-pixels
-  int32_t overlap = particleHardRadius << 1; // overlap bins to include edge particles to neighbouring bins
-  if (advPartProps) //may be using individual particle size
-    overlap += 512; // add 2 * max radius (approximately)
-  uint32_t maxBinParticles = max((uint32_t)50, (usedParticles + 1) / 2); // assume no more than half of the particles are in the same bin, do not bin small amounts of particles
-  uint32_t numBins = (maxX + (BIN_WIDTH - 1)) / BIN_WIDTH; // number of bins in x direction
-  uint16_t binIndices[maxBinParticles]; // creat array on stack for indices, 2kB max for 1024 particles (ESP32_MAXPARTICLES/2)
-  uint32_t binParticleCount; // number of particles in the current bin
-  uint16_t nextFrameStartIdx = hw_random16(usedParticles); // index of the first particle in the next frame (set to fixed value if bin overflow)
-  uint32_t pidx = collisionStartIdx; //start index in case a bin is full, process remaining particles next frame
-
-  // fill the binIndices array for this bin
-  for (uint32_t bin = 0; bin < numBins; bin++) {
-    binParticleCount = 0; // reset for this bin
-    int32_t binStart = bin * BIN_WIDTH - overlap; // note: first bin will extend to negative, but that is ok as out of bounds particles are ignored
-    int32_t binEnd = binStart + BIN_WIDTH + overlap; // note: last bin can be out of bounds, see above;
-
-    // fill the binIndices array for this bin
-    for (uint32_t i = 0; i < usedParticles; i++) {
-      if (particles[pidx].ttl > 0) { // is alive
-        if (particles[pidx].x >= binStart && particles[pidx].x <= binEnd) { // >= and <= to include particles on the edge of the bin (overlap to ensure boarder particles collide with adjacent bins)
-          if(particleFlags[pidx].outofbounds == 0 && particleFlags[pidx].collide) { // particle is in frame and does collide note: checking flags is quite slow and usually these are set, so faster to check here
-            if (binParticleCount >= maxBinParticles) { // bin is full, more particles in this bin so do the rest next frame
-              nextFrameStartIdx = pidx; // bin overflow can only happen once as bin size is at least half of the particles (or half +1)
-              break;
-            }
-            binIndices[binParticleCount++] = pidx;
-          }
-        }
+
+  // cell size is a power of two so cell coordinates are a shift, it must be at least the max collision distance so close particles are in the same or in adjacent cells
+  uint32_t cellShift = PS_P_RADIUS_SHIFT + 1;
+  while ((1U << cellShift) < maxCollDist) cellShift++;
+  uint32_t maxCells = max(usedParticles, (uint32_t)16);
+  uint32_t gridW, gridH;
+  while (true) {
+    gridW = (maxX >> cellShift) + 1;
+    gridH = (maxY >> cellShift) + 1;
+    if (gridW * gridH <= maxCells) break;
+    cellShift++;
+  }
+  const uint32_t numCells = gridW * gridH;
+
+  // the grid lives in the segment data (see collisionGridLength()): cell counters (numCells + 1) followed by the sorted particle indices
+  uint16_t *cellCount = collisionGrid; // after sorting cellCount[c] is the end index of cell c (and start of cell c+1)
+  uint16_t *sortedIdx = collisionGrid + numCells + 1;
+  memset(cellCount, 0, (numCells + 1) * sizeof(uint16_t));
+
+  // counting sort by cell of lookahead position (collisions are checked using lookahead, see below)
+  auto cellOf = [&](const uint32_t i) -> uint32_t {
+    int32_t cx = (particles[i].x + particles[i].vx) >> cellShift; // note: arithmetic right shift, negative positions give negative cells
+    int32_t cy = (particles[i].y + particles[i].vy) >> cellShift;
+    cx = constrain(cx, 0, (int32_t)gridW - 1); // clamping keeps neighbouring particles in neighbouring cells
+    cy = constrain(cy, 0, (int32_t)gridH - 1);
+    return cx + cy * gridW;
+  };
+  for (uint32_t i = 0; i < usedParticles; i++) {
+    if (particles[i].ttl > 0 && particleFlags[i].outofbounds == 0 && particleFlags[i].collide) // is alive, in frame and does collide
+      cellCount[cellOf(i) + 1]++; // count into next cell so prefix sum below gives start indices
+  }
+  for (uint32_t c = 1; c <= numCells; c++)
+    cellCount[c] += cellCount[c - 1]; // cellCount[c] is now the start index of cell c
+  for (uint32_t i = 0; i < usedParticles; i++) {
+    if (particles[i].ttl > 0 && particleFlags[i].outofbounds == 0 && particleFlags[i].collide)
+      sortedIdx[cellCount[cellOf(i)]++] = i; // after this, cellCount[c] is the end index of cell c
+  }
+
+  // check all pairs in a cell against each other and against the forward neighbour cells
+  #ifdef WLED_PS_DUALCORE
+  if (usedParticles >= PS_DUALCORE_MINPARTICLES && gridH >= 4) {
+    // row r checks cell rows r and r+1: the lower rows up to the seam and the upper rows above it touch disjoint particles and run in parallel, the seam row is checked afterwards
+    PScollisionGrid grid = {this, cellCount, sortedIdx, gridW, gridH, collDistSq};
+    runOnBothCores(collisionJob, &grid);
+    const uint32_t seam = (gridH >> 1) - 1;
+    collideCellRows(cellCount, sortedIdx, gridW, gridH, seam, seam + 1, collDistSq);
+    return;
+  }
+  #endif
+  collideCellRows(cellCount, sortedIdx, gridW, gridH, 0, gridH, collDistSq);
+}
+
+// check all pairs of cells in rows rowStart to rowEnd-1: each cell against itself and its forward neighbours (E, SW, S, SE)
+void ParticleSystem2D::collideCellRows(const uint16_t *cellCount, const uint16_t *sortedIdx, const uint32_t gridW, const uint32_t gridH, const uint32_t rowStart, const uint32_t rowEnd, uint32_t collDistSq) {
+  for (uint32_t cy = rowStart; cy < rowEnd; cy++) {
+    for (uint32_t cx = 0; cx < gridW; cx++) {
+      const uint32_t cell = cx + cy * gridW;
+      const uint32_t cellStart = cell ? cellCount[cell - 1] : 0;
+      const uint32_t cellEnd = cellCount[cell];
+      if (cellStart == cellEnd) continue; // empty cell
+      // neighbour cells to check: self, E, SW, S, SE (the other four neighbours check against this cell)
+      uint32_t neighbours[5];
+      uint32_t numNeighbours = 0;
+      neighbours[numNeighbours++] = cell;
+      if (cx + 1 < gridW) neighbours[numNeighbours++] = cell + 1;
+      if (cy + 1 < gridH) {
+        if (cx > 0) neighbours[numNeighbours++] = cell + gridW - 1;
+        neighbours[numNeighbours++] = cell + gridW;
+        if (cx + 1 < gridW) neighbours[numNeighbours++] = cell + gridW + 1;
       }
-      pidx++;
-      if (pidx >= usedParticles) pidx = 0; // wrap around
-    }
 
-    for (uint32_t i = 0; i < binParticleCount; i++) { // go though all 'higher number' particles in this bin and see if any of those are in close proximity and if they are, make them collide
-      uint32_t idx_i = binIndices[i];
-      for (uint32_t j = i + 1; j < binParticleCount; j++) { // check against higher number particles
-        uint32_t idx_j = binIndices[j];
-        if (advPartProps) { //may be using individual particle size
-          setParticleSize(particlesize); // updates base particleHardRadius
-          collDistSq = (particleHardRadius << 1) + (((uint32_t)advPartProps[idx_i].size + (uint32_t)advPartProps[idx_j].size) >> 1); // collision distance note: not 100% clear why the >> 1 is needed, but it is.
-          collDistSq = collDistSq * collDistSq; // square it for faster comparison
-        }
-        int32_t dx = (particles[idx_j].x + particles[idx_j].vx) - (particles[idx_i].x + particles[idx_i].vx); // distance with lookahead
-        if (dx * dx < collDistSq) { // check x direction, if close, check y direction (squaring is faster than abs() or dual compare)
-          int32_t dy = (particles[idx_j].y + particles[idx_j].vy)  - (particles[idx_i].y + particles[idx_i].vy); // distance with lookahead
-          if (dy * dy < collDistSq) // particles are close
-            collideParticles(particles[idx_i], particles[idx_j], dx, dy, collDistSq);
+      for (uint32_t i = cellStart; i < cellEnd; i++) {
+        const uint32_t idx_i = sortedIdx[i];
+        const int32_t xi = particles[idx_i].x + particles[idx_i].vx; // position with lookahead
+        const int32_t yi = particles[idx_i].y + particles[idx_i].vy;
+        for (uint32_t n = 0; n < numNeighbours; n++) {
+          const uint32_t ncell = neighbours[n];
+          const uint32_t jStart = (n == 0) ? i + 1 : cellCount[ncell - 1]; // in own cell, check against higher index particles only. note: neighbour cells are never cell 0
+          const uint32_t jEnd = cellCount[ncell];
+          for (uint32_t j = jStart; j < jEnd; j++) {
+            const uint32_t idx_j = sortedIdx[j];
+            if (advPartProps) { //may be using individual particle size
+              collDistSq = (particleHardRadius << 1) + (((uint32_t)advPartProps[idx_i].size + (uint32_t)advPartProps[idx_j].size) >> 1); // collision distance note: not 100% clear why the >> 1 is needed, but it is.
+              collDistSq = collDistSq * collDistSq; // square it for faster comparison
+            }
+            int32_t dx = (particles[idx_j].x + particles[idx_j].vx) - xi; // distance with lookahead
+            if (dx * dx < (int32_t)collDistSq) { // check x direction, if close, check y direction (squaring is faster than abs() or dual compare)
+              int32_t dy = (particles[idx_j].y + particles[idx_j].vy) - yi; // distance with lookahead
+              if (dy * dy < (int32_t)collDistSq) // particles are close
+                collideParticles(particles[idx_i], particles[idx_j], dx, dy, collDistSq);
+            }
+          }
         }
       }
     }
   }
-  collisionStartIdx = nextFrameStartIdx; // set the start index for the next frame
 }
 
 // handle a collision if close proximity is detected, i.e. dx and/or dy smaller than 2*PS_P_RADIUS
@@ -988,7 +1237,9 @@ void ParticleSystem2D::updatePSpointers(bool isadvanced, bool sizecontrol) {
   particleFlags = reinterpret_cast<PSparticleFlags *>(particles + numParticles); // pointer to particle flags
   sources = reinterpret_cast<PSsource *>(particleFlags + numParticles); // pointer to source(s) at data+sizeof(ParticleSystem2D)
   framebuffer = SEGMENT.getPixels(); // pointer to framebuffer
-  PSdataEnd = reinterpret_cast<uint8_t *>(sources + numSources); // pointer to first available byte after the PS for FX additional data (already aligned to 4 byte boundary)
+  collisionGrid = reinterpret_cast<uint16_t *>(sources + numSources); // pointer to collision grid
+  colorCache = reinterpret_cast<PSColorCache *>(collisionGrid + collisionGridLength(numParticles)); // pointer to color cache(s)
+  PSdataEnd = reinterpret_cast<uint8_t *>(colorCache + PS_RENDER_THREADS); // pointer to first available byte after the PS for FX additional data (already aligned to 4 byte boundary)
   if (isadvanced) {
     advPartProps = reinterpret_cast<PSadvancedParticle *>(PSdataEnd);
     PSdataEnd = reinterpret_cast<uint8_t *>(advPartProps + numParticles);
@@ -1011,6 +1262,7 @@ void ParticleSystem2D::updatePSpointers(bool isadvanced, bool sizecontrol) {
 // for speed, 1D array and 32bit variables are used, make sure to limit them to 8bit (0-255) or result is undefined
 // to blur a subset of the buffer, change the xsize/ysize and set xstart/ystart to the desired starting coordinates (default start is 0/0)
 // subset blurring only works on 10x10 buffer (single particle rendering), if other sizes are needed, buffer width must be passed as parameter
+// note: this duplicates the traversal of blurPixelRows()/blurPixelColumns() (color_math.cpp) but not their math: particles blur additively and ignore white
 void blur2D(uint32_t *colorbuffer, uint32_t xsize, uint32_t ysize, uint32_t xblur, uint32_t yblur, uint32_t xstart, uint32_t ystart, bool isparticle) {
   CRGBW seeppart, carryover;
   uint32_t seep = xblur >> 1;
@@ -1042,19 +1294,25 @@ void blur2D(uint32_t *colorbuffer, uint32_t xsize, uint32_t ysize, uint32_t xblu
     ysize++;
   }
 
+  // columns are blurred in blocks walking down the rows, so memory is accessed in contiguous chunks instead of one pixel per row
+  constexpr uint32_t BLOCK = 8;
+  CRGBW carryovers[BLOCK];
   seep = yblur >> 1;
-  for (uint32_t x = xstart; x < xstart + xsize; x++) {
-    carryover = BLACK;
+  for (uint32_t x = xstart; x < xstart + xsize; x += BLOCK) {
+    const uint32_t n = min(BLOCK, xstart + xsize - x);
+    for (uint32_t c = 0; c < n; c++) carryovers[c] = BLACK;
     uint32_t indexXY = x + ystart * width;
     for (uint32_t y = ystart; y < ystart + ysize; y++) {
-      seeppart = fast_color_scale(colorbuffer[indexXY], seep); // scale it and seep to neighbours
-      if (y > 0) {
-        colorbuffer[indexXY - width] = fast_color_add(colorbuffer[indexXY - width], seeppart);
-        if (carryover.color32) // note: check adds overhead but is faster on average
-          colorbuffer[indexXY] = fast_color_add(colorbuffer[indexXY], carryover);
+      for (uint32_t c = 0; c < n; c++) {
+        seeppart = fast_color_scale(colorbuffer[indexXY + c], seep); // scale it and seep to neighbours
+        if (y > 0) {
+          colorbuffer[indexXY + c - width] = fast_color_add(colorbuffer[indexXY + c - width], seeppart);
+          if (carryovers[c].color32) // note: check adds overhead but is faster on average
+            colorbuffer[indexXY + c] = fast_color_add(colorbuffer[indexXY + c], carryovers[c]);
+        }
+        carryovers[c] = seeppart;
       }
-      carryover = seeppart;
-      indexXY += width; // next pixel in y direction
+      indexXY += width; // next pixel row
     }
   }
 }
@@ -1095,6 +1353,8 @@ bool allocateParticleSystemMemory2D(uint32_t numparticles, uint32_t numsources,
   if (sizecontrol)
     requiredmemory += sizeof(PSsizeControl) * numparticles;
   requiredmemory += sizeof(PSsource) * numsources;
+  requiredmemory += sizeof(uint16_t) * collisionGridLength(numparticles);
+  requiredmemory += sizeof(PSColorCache) * PS_RENDER_THREADS;
   requiredmemory += additionalbytes;
   return(SEGMENT.allocateData(requiredmemory));
 }
@@ -1154,8 +1414,10 @@ ParticleSystem1D::ParticleSystem1D(uint32_t length, uint32_t numberofparticles,
   motionBlur = 0; //no fading by default
   smearBlur = 0; //no smearing by default
   emitIndex = 0;
-  collisionStartIdx = 0;
   // initialize some default non-zero values most FX use
+  for (uint32_t i = 0; i < numParticles; i++) {
+    collisionOrder[i] = i; // collision detection keeps this sorted by position
+  }
   for (uint32_t i = 0; i < numSources; i++) {
     sources[i].source.ttl = 1; //set source alive
     sources[i].sourceFlags.asByte = 0; // all flags disabled
@@ -1179,9 +1441,7 @@ void ParticleSystem1D::update(void) {
     handleCollisions();
 
   //move all particles
-  for (uint32_t i = 0; i < usedParticles; i++) {
-    particleMoveUpdate(particles[i], particleFlags[i], nullptr, advPartProps ? &advPartProps[i] : nullptr);
-  }
+  moveParticles();
 
   if (particlesettings.colorByPosition) {
     uint32_t scale = (255 << 16) / maxX;  // speed improvement: multiplication is faster than division
@@ -1289,13 +1549,23 @@ int32_t ParticleSystem1D::sprayEmit(const PSsource1D &emitter) {
 // particle moves, decays and dies, if killoutofbounds is set, out of bounds particles are set to ttl=0
 // uses passed settings to set bounce or wrap, if useGravity is set, it will never bounce at the top and killoutofbounds is not applied over the top
 void ParticleSystem1D::particleMoveUpdate(PSparticle1D &part, PSparticleFlags1D &partFlags, PSsettings1D *options, PSadvancedParticle1D *advancedproperties) {
-  if (options == nullptr)
-    options = &particlesettings; // use PS system settings by default
+  moveParticle(part, partFlags, options ? *options : particlesettings, advancedproperties); // use PS system settings by default
+}
+
+// move all used particles in one pass (see 2D version for details)
+void ParticleSystem1D::moveParticles() {
+  const PSsettings1D options = particlesettings;
+  for (uint32_t i = 0; i < usedParticles; i++) {
+    moveParticle(particles[i], particleFlags[i], options, advPartProps ? &advPartProps[i] : nullptr);
+  }
+}
 
+// move a particle: apply velocity, handle walls and bounds
+inline void ParticleSystem1D::moveParticle(PSparticle1D &part, PSparticleFlags1D &partFlags, const PSsettings1D &options, PSadvancedParticle1D *advancedproperties) {
   if (part.ttl > 0) {
     if (!partFlags.perpetual)
       part.ttl--; // age
-    if (options->colorByAge)
+    if (options.colorByAge)
       part.hue = min(part.ttl, (uint16_t)255); // set color to ttl
 
     int32_t renderradius = PS_P_HALFRADIUS_1D; // used to check out of bounds, default for 2 pixel rendering
@@ -1311,10 +1581,10 @@ void ParticleSystem1D::particleMoveUpdate(PSparticle1D &part, PSparticleFlags1D
     }
 
     // if wall collisions are enabled, bounce them before they reach the edge, it looks much nicer if the particle is not half out of view
-    if (options->bounce) {
+    if (options.bounce) {
       if ((newX < (int32_t)particleHardRadius) || ((newX > (int32_t)(maxX - particleHardRadius)))) { // reached a wall
         bool bouncethis = true;
-        if (options->useGravity) {
+        if (options.useGravity) {
           if (partFlags.reversegrav) { // skip bouncing at x = 0
             if (newX < (int32_t)particleHardRadius)
               bouncethis = false;
@@ -1333,11 +1603,11 @@ void ParticleSystem1D::particleMoveUpdate(PSparticle1D &part, PSparticleFlags1D
       }
     }
 
-    if (!checkBoundsAndWrap(newX, maxX, renderradius, options->wrap)) { // check out of bounds note: this must not be skipped or it can lead to crashes
+    if (!checkBoundsAndWrap(newX, maxX, renderradius, options.wrap)) { // check out of bounds note: this must not be skipped or it can lead to crashes
       partFlags.outofbounds = true;
-      if (options->killoutofbounds) {
+      if (options.killoutofbounds) {
         bool killthis = true;
-        if (options->useGravity) { // if gravity is used, only kill below 'floor level'
+        if (options.useGravity) { // if gravity is used, only kill below 'floor level'
           if (partFlags.reversegrav) { // skip at x = 0, do not skip far out of bounds
             if (newX < 0 || newX > maxX << 2)
               killthis = false;
@@ -1442,22 +1712,14 @@ void ParticleSystem1D::render() {
   }
 
   // go over particles and render them to the buffer
+  colorCache[0].reset(blend);
   for (uint32_t i = 0; i < usedParticles; i++) {
     if ( particles[i].ttl == 0 || particleFlags[i].outofbounds)
       continue;
 
     // generate RGB values for particle
     brightness = min(particles[i].ttl << 1, (int)255);
-    baseRGB = ColorFromPaletteWLED(SEGPALETTE, particles[i].hue, 255, blend);
-
-    if (advPartProps) { //saturation is advanced property in 1D system
-      if (advPartProps[i].sat < 255) {
-        CHSV32 baseHSV;
-        rgb2hsv(baseRGB.color32, baseHSV); // convert to HSV
-        baseHSV.s = min(baseHSV.s, advPartProps[i].sat); // set the saturation but don't increase it
-        hsv2rgb(baseHSV, baseRGB.color32); // convert back to RGB
-      }
-    }
+    baseRGB = colorCache[0].color(particles[i].hue, advPartProps ? advPartProps[i].sat : 255); // saturation is advanced property in 1D system
     if(gammaCorrectBri) brightness = gamma8(brightness); // apply gamma correction, used for gamma-inverted brightness distribution
     renderParticle(i, brightness, baseRGB, particlesettings.wrap);
   }
@@ -1593,58 +1855,53 @@ __attribute__((optimize("O2"))) void ParticleSystem1D::renderParticle(const uint
 }
 
 // detect collisions in an array of particles and handle them
+// uses sort and sweep: collisionOrder is a persistent array of particle indices that is kept sorted by (lookahead) position
+// particles move only a little each frame so the array is nearly sorted and an insertion sort is close to linear
+// after sorting, each particle is only checked against its right hand neighbours until they are out of collision distance
 void ParticleSystem1D::handleCollisions() {
   uint32_t collisiondistance = particleHardRadius << 1;
-  // note: partices are binned by position, assumption is that no more than half of the particles are in the same bin
-  // if they are, collisionStartIdx is increased so each particle collides at least every second frame (which still gives decent collisions)
-  constexpr int BIN_WIDTH = 32 * PS_P_RADIUS_1D; // width of each bin, a compromise between speed and accuracy (larger bins are faster but collapse more)
-  int32_t overlap = particleHardRadius << 1; // overlap bins to include edge particles to neighbouring bins
+  uint32_t maxCollisionDistance = collisiondistance;
   if (advPartProps) //may be using individual particle size
-    overlap += 256; // add 2 * max radius (approximately)
-  uint32_t maxBinParticles = max((uint32_t)50, (usedParticles + 1) / 4); // do not bin small amounts, limit max to 1/4 of particles
-  uint32_t numBins = (maxX + (BIN_WIDTH - 1)) / BIN_WIDTH; // calculate number of bins
-  uint16_t binIndices[maxBinParticles]; // array to store indices of particles in a bin
-  uint32_t binParticleCount; // number of particles in the current bin
-  uint16_t nextFrameStartIdx = hw_random16(usedParticles); // index of the first particle in the next frame (set to fixed value if bin overflow)
-  uint32_t pidx = collisionStartIdx; //start index in case a bin is full, process remaining particles next frame
-  for (uint32_t bin = 0; bin < numBins; bin++) {
-    binParticleCount = 0; // reset for this bin
-    int32_t binStart = bin * BIN_WIDTH - overlap; // note: first bin will extend to negative, but that is ok as out of bounds particles are ignored
-    int32_t binEnd = binStart + BIN_WIDTH + overlap; // note: last bin can be out of bounds, see above
-
-    // fill the binIndices array for this bin
-    for (uint32_t i = 0; i < usedParticles; i++) {
-      if (particles[pidx].ttl > 0) { // alivee
-        if (particles[pidx].x >= binStart && particles[pidx].x <= binEnd) { // >= and <= to include particles on the edge of the bin (overlap to ensure boarder particles collide with adjacent bins)
-          if(particleFlags[pidx].outofbounds == 0 && particleFlags[pidx].collide) { // particle is in frame and does collide note: checking flags is quite slow and usually these are set, so faster to check here
-            if (binParticleCount >= maxBinParticles) { // bin is full, more particles in this bin so do the rest next frame
-              nextFrameStartIdx = pidx; // bin overflow can only happen once as bin size is at least half of the particles (or half +1)
-              break;
-            }
-            binIndices[binParticleCount++] = pidx;
-          }
-        }
-      }
-      pidx++;
-      if (pidx >= usedParticles) pidx = 0; // wrap around
+    maxCollisionDistance = max(maxCollisionDistance, (uint32_t)(PS_P_MINHARDRADIUS_1D << particlesize) + 255); // max size of two particles, see collision distance below
+
+  // move all colliding particles to the front, keeping their relative order from last frame (non colliding particles are kept behind them in any order)
+  uint32_t numColliding = 0;
+  for (uint32_t i = 0; i < numParticles; i++) {
+    uint32_t idx = collisionOrder[i];
+    if (idx < usedParticles && particles[idx].ttl > 0 && particleFlags[idx].outofbounds == 0 && particleFlags[idx].collide) { // is used, alive, in frame and does collide
+      collisionOrder[i] = collisionOrder[numColliding];
+      collisionOrder[numColliding++] = idx;
     }
+  }
 
-    for (uint32_t i = 0; i < binParticleCount; i++) { // go though all 'higher number' particles and see if any of those are in close proximity and if they are, make them collide
-      uint32_t idx_i = binIndices[i];
-      for (uint32_t j = i + 1; j < binParticleCount; j++) { // check against higher number particles
-        uint32_t idx_j = binIndices[j];
-        if (advPartProps) { // use advanced size properties
-          collisiondistance = (PS_P_MINHARDRADIUS_1D << particlesize) + ((advPartProps[idx_i].size + advPartProps[idx_j].size) >> 1);
-        }
-        int32_t dx = (particles[idx_j].x + particles[idx_j].vx) - (particles[idx_i].x + particles[idx_i].vx); // distance between particles with lookahead
-        uint32_t dx_abs = abs(dx);
-        if (dx_abs <= collisiondistance) { // collide if close
-          collideParticles(particles[idx_i], particleFlags[idx_i], particles[idx_j], particleFlags[idx_j], dx, dx_abs, collisiondistance);
-        }
+  // insertion sort by position with lookahead (collisions are checked using lookahead, see below)
+  for (uint32_t i = 1; i < numColliding; i++) {
+    uint32_t idx = collisionOrder[i];
+    int32_t pos = particles[idx].x + particles[idx].vx;
+    uint32_t j = i;
+    while (j > 0 && (particles[collisionOrder[j - 1]].x + particles[collisionOrder[j - 1]].vx) > pos) {
+      collisionOrder[j] = collisionOrder[j - 1];
+      j--;
+    }
+    collisionOrder[j] = idx;
+  }
+
+  // sweep: check each particle against the following particles that are within collision distance
+  for (uint32_t i = 0; i < numColliding; i++) {
+    uint32_t idx_i = collisionOrder[i];
+    for (uint32_t j = i + 1; j < numColliding; j++) {
+      uint32_t idx_j = collisionOrder[j];
+      int32_t dx = (particles[idx_j].x + particles[idx_j].vx) - (particles[idx_i].x + particles[idx_i].vx); // distance between particles with lookahead
+      uint32_t dx_abs = abs(dx); // note: dx can be negative if a collision pushed a particle, see collideParticles()
+      if (dx > (int32_t)maxCollisionDistance) break; // all following particles are further away
+      if (advPartProps) { // use advanced size properties
+        collisiondistance = (PS_P_MINHARDRADIUS_1D << particlesize) + ((advPartProps[idx_i].size + advPartProps[idx_j].size) >> 1);
+      }
+      if (dx_abs <= collisiondistance) { // collide if close
+        collideParticles(particles[idx_i], particleFlags[idx_i], particles[idx_j], particleFlags[idx_j], dx, dx_abs, collisiondistance);
       }
     }
   }
-  collisionStartIdx = nextFrameStartIdx; // set the start index for the next frame
 }
 // handle a collision if close proximity is detected, i.e. dx and/or dy smaller than 2*PS_P_RADIUS
 // takes two pointers to the particles to collide and the particle hardness (softer means more energy lost in collision, 255 means full hard)
@@ -1735,11 +1992,13 @@ void ParticleSystem1D::updatePSpointers(bool isadvanced) {
   // by making sure that the number of sources and particles is a multiple of 4, padding can be skipped here as alignent is ensured, independent of struct sizes.
   particles = reinterpret_cast<PSparticle1D *>(this + 1); // pointer to particles
   particleFlags = reinterpret_cast<PSparticleFlags1D *>(particles + numParticles); // pointer to particle flags
-  sources = reinterpret_cast<PSsource1D *>(particleFlags + numParticles); // pointer to source(s)
-  PSdataEnd = reinterpret_cast<uint8_t *>(sources + numSources);   // pointer to first available byte after the PS for FX additional data (already aligned to 4 byte boundary)
+  collisionOrder = reinterpret_cast<uint16_t *>(particleFlags + numParticles); // pointer to particle index array used for collision detection
+  sources = reinterpret_cast<PSsource1D *>(collisionOrder + numParticles); // pointer to source(s)
+  colorCache = reinterpret_cast<PSColorCache *>(sources + numSources); // pointer to color cache
+  PSdataEnd = reinterpret_cast<uint8_t *>(colorCache + 1);   // pointer to first available byte after the PS for FX additional data (already aligned to 4 byte boundary)
 #ifndef WLED_DISABLE_2D
   if(SEGMENT.is2D() && SEGMENT.map1D2D) {
-    framebuffer = reinterpret_cast<uint32_t *>(sources + numSources); // use local framebuffer for 1D->2D mapping
+    framebuffer = reinterpret_cast<uint32_t *>(colorCache + 1); // use local framebuffer for 1D->2D mapping
     PSdataEnd = reinterpret_cast<uint8_t *>(framebuffer + SEGMENT.maxMappingLength()); // pointer to first available byte after the PS for FX additional data (still aligned to 4 byte boundary)
   }
   else
@@ -1791,7 +2050,9 @@ bool allocateParticleSystemMemory1D(const uint32_t numparticles, const uint32_t
   // functions above make sure these are a multiple of 4 bytes (to avoid alignment issues)
   requiredmemory += sizeof(PSparticleFlags1D) * numparticles;
   requiredmemory += sizeof(PSparticle1D) * numparticles;
+  requiredmemory += sizeof(uint16_t) * numparticles; // collision order
   requiredmemory += sizeof(PSsource1D) * numsources;
+  requiredmemory += sizeof(PSColorCache);
 #ifndef WLED_DISABLE_2D
   if(SEGMENT.is2D())
     requiredmemory += sizeof(uint32_t) * SEGMENT.maxMappingLength(); // need local buffer for mapped rendering
@@ -22,6 +22,18 @@
 
 //#define WLED_DEBUG_PS // note: enabling debug uses ~3k of flash
 
+// dual core 2D particle system (opt-in with -D WLED_PS_DUALCORE): collisions, particle moving and rendering are split between both cores of an ESP32
+// note: the second core also runs WiFi, heavy PS effects may affect network responsiveness
+#if defined(WLED_PS_DUALCORE) && (!defined(ARDUINO_ARCH_ESP32) || defined(CONFIG_FREERTOS_UNICORE))
+  #undef WLED_PS_DUALCORE // single core chip
+#endif
+#ifdef WLED_PS_DUALCORE
+  #define PS_RENDER_THREADS 2
+  #define PS_DUALCORE_MINPARTICLES 256 // estimate, not measured on hardware: below this, handing work to the other core likely costs more than it saves
+#else
+  #define PS_RENDER_THREADS 1
+#endif
+
 #ifdef WLED_DEBUG_PS
   #define PSPRINT(x) Serial.print(x)
   #define PSPRINTLN(x) Serial.println(x)
@@ -30,6 +42,8 @@
   #define PSPRINTLN(x)
 #endif
 
+class PSColorCache; // per frame palette color cache, one per render thread is kept in the segment data of each particle system (FXparticleSystem.cpp)
+
 // limit speed of particles (used in 1D and 2D)
 static inline int32_t limitSpeed(const int32_t speed) {
   return speed > PS_P_MAXSPEED ? PS_P_MAXSPEED : (speed < -PS_P_MAXSPEED ? -PS_P_MAXSPEED : speed); // note: this is slightly faster than using min/max at the cost of 50bytes of flash
@@ -59,6 +73,7 @@ static inline int32_t limitSpeed(const int32_t speed) {
 #define PS_P_SURFACE 12 // shift: 2^PS_P_SURFACE = (PS_P_RADIUS)^2
 #define PS_P_MINHARDRADIUS 64 // minimum hard surface radius for collisions
 #define PS_P_MINSURFACEHARDNESS 128 // minimum hardness used in collision impulse calculation, below this hardness, particles become sticky
+#define PS_MIN_BUDGET 64 // minimum adaptive particle budget (64 = 25% of particles)
 
 // struct for PS settings (shared for 1D and 2D class)
 typedef union {
@@ -195,12 +210,24 @@ public:
 private:
   //rendering functions
   void render();
-  [[gnu::hot]] void renderParticle(const uint32_t particleindex, const uint8_t brightness, const CRGBW& color, const bool wrapX, const bool wrapY);
+  void renderParticles(const int32_t yStart, const int32_t yEnd, const uint32_t cacheIndex); // render particles to frame buffer rows yStart-yEnd
+  [[gnu::hot]] void renderParticle(const uint32_t particleindex, const uint8_t brightness, const CRGBW& color, const bool wrapX, const bool wrapY, const int32_t yStart, const int32_t yEnd);
   //paricle physics applied by system if flags are set
   void applyGravity(); // applies gravity to all particles
+  void moveParticles(); // applies particleMoveUpdate() to all used particles
+  [[gnu::always_inline]] inline void moveParticle(PSparticle &part, PSparticleFlags &partFlags, const PSsettings2D &options, PSadvancedParticle *advancedproperties);
+  #ifdef WLED_PS_DUALCORE
+  static void moveJob(void *context, const uint32_t part); // dual core jobs, part is 0 or 1
+  static void renderJob(void *context, const uint32_t part);
+  static void collisionJob(void *context, const uint32_t part);
+  #endif
   void handleCollisions();
+  void collideCellRows(const uint16_t *cellCount, const uint16_t *sortedIdx, const uint32_t gridW, const uint32_t gridH, const uint32_t rowStart, const uint32_t rowEnd, uint32_t collDistSq); // check cell rows rowStart to rowEnd-1 against themselves and the next row
   [[gnu::hot]] void collideParticles(PSparticle &particle1, PSparticle &particle2, const int32_t dx, const int32_t dy, const uint32_t collDistSq);
   void fireParticleupdate();
+  //adaptive particle budget
+  void updateBudget(const uint32_t elapsed); // adjust budget to measured PS work time
+  void applyBudget(); // update usedParticles from requested particles and budget
   //utility functions
   void updatePSpointers(const bool isadvanced, const bool sizecontrol); // update the data pointers to current segment data space
   bool updateSize(PSadvancedParticle *advprops, PSsizeControl *advsize); // advanced size control
@@ -208,6 +235,8 @@ private:
   [[gnu::hot]] void bounce(int8_t &incomingspeed, int8_t &parallelspeed, int32_t &position, const uint32_t maxposition); // bounce on a wall
   // note: variables that are accessed often are 32bit for speed
   uint32_t *framebuffer; // frame buffer for rendering. note: using CRGBW as the buffer is slower, ESP compiler seems to optimize this better giving more consistent FPS
+  uint16_t *collisionGrid; // scratch buffer for collision detection (in segment data): cell counters followed by the particle indices sorted by cell
+  PSColorCache *colorCache; // color cache for each render thread (in segment data)
   PSsettings2D particlesettings; // settings used when updating particles (can also used by FX to move sources), do not edit properties directly, use functions above
   uint32_t numParticles;  // total number of particles allocated by this system
   uint32_t emitIndex; // index to count through particles to emit so searching for dead pixels is faster
@@ -215,7 +244,10 @@ private:
   uint32_t wallHardness;
   uint32_t wallRoughness; // randomizes wall collisions
   uint32_t particleHardRadius; // hard surface radius of a particle, used for collision detection (32bit for speed)
-  uint16_t collisionStartIdx; // particle array start index for collision detection
+  uint32_t requestedParticles; // number of particles set by FX, usedParticles is scaled down from this by the particle budget
+  uint32_t workTime; // smoothed time used by update and render in us
+  uint8_t particleBudget; // adaptive particle budget, 255 = use all requested particles
+  uint8_t budgetCounter; // frame counter for budget adjustments
   uint8_t fireIntesity = 0; // fire intensity, used for fire mode (flash use optimization, better than passing an argument to render function)
   uint8_t forcecounter; // counter for globally applied forces
   uint8_t gforcecounter; // counter for global gravity
@@ -368,6 +400,8 @@ private:
 
   //paricle physics applied by system if flags are set
   void applyGravity(); // applies gravity to all particles
+  void moveParticles(); // applies particleMoveUpdate() to all used particles
+  [[gnu::always_inline]] inline void moveParticle(PSparticle1D &part, PSparticleFlags1D &partFlags, const PSsettings1D &options, PSadvancedParticle1D *advancedproperties);
   void handleCollisions();
   [[gnu::hot]] void collideParticles(PSparticle1D &particle1, const PSparticleFlags1D &particle1flags, PSparticle1D &particle2, const PSparticleFlags1D &particle2flags, const int32_t dx, const uint32_t dx_abs, const uint32_t collisiondistance);
 
@@ -377,6 +411,8 @@ private:
   [[gnu::hot]] void bounce(int8_t &incomingspeed, int8_t &parallelspeed, int32_t &position, const uint32_t maxposition); // bounce on a wall
   // note: variables that are accessed often are 32bit for speed
   uint32_t *framebuffer; // frame buffer for rendering. note: using CRGBW as the buffer is slower, ESP compiler seems to optimize this better giving more consistent FPS
+  uint16_t *collisionOrder; // particle indices sorted by position, persistent over frames for fast sorting in collision detection
+  PSColorCache *colorCache; // color cache for rendering (in segment data)
   PSsettings1D particlesettings; // settings used when updating particles
   uint32_t numParticles;  // total number of particles allocated by this system
   uint32_t emitIndex; // index to count through particles to emit so searching for dead pixels is faster
@@ -386,7 +422,6 @@ private:
   uint8_t gforcecounter; // counter for global gravity
   int8_t gforce; // gravity strength, default is 8 (negative is allowed, positive is downwards)
   uint8_t forcecounter; // counter for globally applied forces
-  uint16_t collisionStartIdx; // particle array start index for collision detection
   //global particle properties for basic particles
   uint8_t particlesize; // global particle size, 0 = 1 pixel, 1 = 2 pixels, is overruled by advanced particle size
   uint8_t motionBlur; // enable motion blur, values > 100 gives smoother animations
@@ -0,0 +1,109 @@
+#pragma once
+#ifndef WLED_API_REQUEST_H
+#define WLED_API_REQUEST_H
+
+/*
+ * Tokenizer for the legacy HTTP API used by handleSet() (set.cpp)
+ * only depends on Arduino.h so it can be unit tested on the host (see test/test_api)
+ */
+
+#include <Arduino.h>
+
+void parseNumber(const char* str, byte &val, byte minv, byte maxv); // util.cpp
+
+// HTTP API parameter keys (the part between '&' and '='), packed big-endian into 32 bits
+// so that numeric order equals alphabetical order; apiKeys[] MUST stay sorted (checked below)
+enum ApiParam : uint8_t {
+  API_A,  API_B,  API_B2, API_C2, API_C3, API_CL, API_CT, API_FP, API_FX, API_FXD, API_G,  API_G2, API_GP,
+  API_H2, API_HU, API_IN, API_IX, API_K,  API_K2, API_LO, API_LX, API_LY,  API_M,  API_M1, API_M2,
+  API_M3, API_MI, API_ND, API_NF, API_NL, API_NM, API_NN, API_NP, API_NT,  API_OL, API_P1, API_P2,
+  API_PL, API_PS, API_R,  API_R2, API_RB, API_RD, API_RN, API_RV, API_S,   API_S2, API_SA, API_SB,
+  API_SC, API_SM, API_SN, API_SP, API_SR, API_SS, API_ST, API_SV, API_SW,  API_SX, API_T,  API_TT,
+  API_U0, API_U1, API_W,  API_W2, API_X1, API_X2, API_X3,
+  API_COUNT
+};
+
+static constexpr uint32_t apiKey(const char *k, unsigned n = 4) {
+  return n == 0 ? 0 : ((uint32_t)(uint8_t)k[0] << (8*(n-1))) | (k[0] ? apiKey(k+1, n-1) : 0);
+}
+
+static constexpr uint32_t apiKeys[API_COUNT] PROGMEM = {
+  apiKey("A"),  apiKey("B"),  apiKey("B2"), apiKey("C2"), apiKey("C3"), apiKey("CL"), apiKey("CT"), apiKey("FP"), apiKey("FX"), apiKey("FXD"), apiKey("G"),  apiKey("G2"), apiKey("GP"),
+  apiKey("H2"), apiKey("HU"), apiKey("IN"), apiKey("IX"), apiKey("K"),  apiKey("K2"), apiKey("LO"), apiKey("LX"), apiKey("LY"),  apiKey("M"),  apiKey("M1"), apiKey("M2"),
+  apiKey("M3"), apiKey("MI"), apiKey("ND"), apiKey("NF"), apiKey("NL"), apiKey("NM"), apiKey("NN"), apiKey("NP"), apiKey("NT"),  apiKey("OL"), apiKey("P1"), apiKey("P2"),
+  apiKey("PL"), apiKey("PS"), apiKey("R"),  apiKey("R2"), apiKey("RB"), apiKey("RD"), apiKey("RN"), apiKey("RV"), apiKey("S"),   apiKey("S2"), apiKey("SA"), apiKey("SB"),
+  apiKey("SC"), apiKey("SM"), apiKey("SN"), apiKey("SP"), apiKey("SR"), apiKey("SS"), apiKey("ST"), apiKey("SV"), apiKey("SW"),  apiKey("SX"), apiKey("T"),  apiKey("TT"),
+  apiKey("U0"), apiKey("U1"), apiKey("W"),  apiKey("W2"), apiKey("X1"), apiKey("X2"), apiKey("X3")
+};
+
+static constexpr bool apiKeysSorted(unsigned i = 1) {
+  return i >= API_COUNT ? true : (apiKeys[i-1] < apiKeys[i] && apiKeysSorted(i+1));
+}
+static_assert(apiKeysSorted(), "apiKeys[] must be sorted in ascending order");
+
+// single pass tokenizer for the legacy HTTP API ("win&A=128&FX=~&...")
+// records the position of the value of the first occurrence of each known "key=value" pair
+// and, separately, which keys were given without a value ("&ND", "&H2", ...)
+// values are not copied and remain terminated by '&' (or end of string)
+class ApiRequest {
+  public:
+    explicit ApiRequest(const char *req) : _req(req) {
+      memset(_pos, 0, sizeof(_pos));
+      memset(_bare, 0, sizeof(_bare));
+      // everything before the first '&' is the "win" command itself
+      for (const char *tok = strchr(req, '&'); tok; tok = strchr(tok, '&')) {
+        tok++; // skip '&'
+        uint32_t key = 0;
+        unsigned len = 0;
+        while (tok[len] && tok[len] != '&' && tok[len] != '=') {
+          if (len < 4) key = (key << 8) | (uint8_t)tok[len];
+          len++;
+        }
+        if (len > 0 && len <= 4) {
+          int idx = find(key << (8*(4-len)));
+          if (idx >= 0) {
+            if (tok[len] != '=')    _bare[idx >> 3] |= 1 << (idx & 7);
+            else if (_pos[idx] == 0) _pos[idx] = (tok - req) + len + 1;
+          }
+        }
+        tok += len;
+      }
+    }
+
+    inline bool has(ApiParam p) const         { return _pos[p] > 0; } // "key=" is present
+    inline bool present(ApiParam p) const     { return has(p) || (_bare[p >> 3] & (1 << (p & 7))); } // "key" is present, with or without value
+    inline const char *value(ApiParam p) const { return _req + _pos[p]; } // only valid if has(p)
+    inline int  num(ApiParam p) const          { return atol(value(p)); } // same as getNumVal()
+    inline bool flag(ApiParam p) const         { return *value(p) != '0'; }
+
+    // same as updateVal() but on the (bounded) value of a parsed key
+    bool update(ApiParam p, byte &val, byte minv = 0, byte maxv = 255) const {
+      if (!has(p)) return false;
+      char buf[16];
+      const char *v = value(p);
+      size_t len = 0;
+      while (len < sizeof(buf)-1 && v[len] && v[len] != '&') { buf[len] = v[len]; len++; }
+      buf[len] = '\0';
+      parseNumber(buf, val, minv, maxv);
+      return true;
+    }
+
+  private:
+    const char *_req;
+    uint16_t    _pos[API_COUNT];          // offset of value in request, 0 if "key=" is not present
+    uint8_t     _bare[(API_COUNT+7) / 8]; // bit set if key is present without '='
+
+    static int find(uint32_t key) {
+      int lo = 0, hi = API_COUNT - 1;
+      while (lo <= hi) {
+        int mid = (lo + hi) >> 1;
+        uint32_t k = pgm_read_dword(&apiKeys[mid]);
+        if (k == key) return mid;
+        if (k < key) lo = mid + 1;
+        else         hi = mid - 1;
+      }
+      return -1;
+    }
+};
+
+#endif
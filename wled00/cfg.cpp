@@ -774,6 +774,28 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
 
 
 static const char s_cfg_json[] PROGMEM = "/cfg.json";
+#ifdef WLED_ENABLE_BOOT_SNAPSHOT
+static const char s_cfg_snap[] PROGMEM = "/cfg.snap";
+
+// parsed cfg.json in MessagePack form (much faster to deserialize than JSON)
+static bool readConfigSnapshot() {
+  File snap = openSnapshot(s_cfg_snap, fileChecksum(s_cfg_json));
+  if (!snap) return false;
+  size_t len = snap.size() - snap.position();
+  char *buf = static_cast<char*>(p_malloc(len));
+  bool success = buf && snap.read((uint8_t*)buf, len) == len && deserializeMsgPack(*pDoc, (const char*)buf, len) == DeserializationError::Ok; // const input: strings are copied
+  p_free(buf);
+  snap.close();
+  if (success) bootSnapshot |= BOOT_SNAPSHOT_CFG;
+  return success;
+}
+
+static void writeConfigSnapshot() {
+  File snap = createSnapshot(s_cfg_snap, fileChecksum(s_cfg_json));
+  if (snap) serializeMsgPack(*pDoc, snap);
+  snap.close();
+}
+#endif
 
 bool deserializeConfigFromFS() {
   [[maybe_unused]] bool success = deserializeConfigSec();
@@ -787,7 +809,15 @@ bool deserializeConfigFromFS() {
 
   DEBUG_PRINTLN(F("Reading settings from /cfg.json..."));
 
+  #ifdef WLED_ENABLE_BOOT_SNAPSHOT
+  success = readConfigSnapshot();
+  if (!success) {
+    success = readObjectFromFile(s_cfg_json, nullptr, pDoc);
+    if (success) writeConfigSnapshot();
+  }
+  #else
   success = readObjectFromFile(s_cfg_json, nullptr, pDoc);
+  #endif
 
   // NOTE: This routine deserializes *and* applies the configuration
   //       Therefore, must also initialize ethernet from this function
@@ -812,6 +842,10 @@ void serializeConfigToFS() {
   File f = WLED_FS.open(FPSTR(s_cfg_json), "w");
   if (f) serializeJson(root, f);
   f.close();
+  invalidateFileCache(s_cfg_json);
+  #ifdef WLED_ENABLE_BOOT_SNAPSHOT
+  writeConfigSnapshot();
+  #endif
   releaseJSONBufferLock();
 
   configNeedsWrite = false;
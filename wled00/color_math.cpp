@@ -0,0 +1,226 @@
+/*
+ * Color math on packed 32bit WRGB values and raw pixel buffers
+ * only depends on Arduino.h so it can be unit tested on the host (see test/test_colors)
+ */
+
+#include <Arduino.h>
+#include "color_math.h"
+
+// same definitions as in wled.h and FX.h (which cannot be included here)
+#define BLACK           (uint32_t)0x000000
+#define RGBW32(r,g,b,w) (uint32_t((byte(w) << 24) | (byte(r) << 16) | (byte(g) << 8) | (byte(b))))
+#define R(c)            (byte((c) >> 16))
+#define G(c)            (byte((c) >> 8))
+#define B(c)            (byte(c))
+#define W(c)            (byte((c) >> 24))
+
+/*
+ * color blend function, based on FastLED blend function
+ * the calculation for each color is: result = (A*(amountOfA) + A + B*(amountOfB) + B) / 256 with amountOfA = 255 - amountOfB
+ */
+uint32_t color_blend(uint32_t color1, uint32_t color2, uint8_t blend) {
+  // min / max blend checking is omitted: calls with 0 or 255 are rare, checking lowers overall performance
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;     // mask for R and B channels or W and G if negated (poorman's SIMD; https://github.com/wled/WLED/pull/4568#discussion_r1986587221)
+  uint32_t rb1 =  color1       & TWO_CHANNEL_MASK;  // extract R & B channels from color1
+  uint32_t wg1 = (color1 >> 8) & TWO_CHANNEL_MASK;  // extract W & G channels from color1 (shifted for multiplication later)
+  uint32_t rb2 =  color2       & TWO_CHANNEL_MASK;  // extract R & B channels from color2
+  uint32_t wg2 = (color2 >> 8) & TWO_CHANNEL_MASK;  // extract W & G channels from color2 (shifted for multiplication later)
+  uint32_t rb3 = ((((rb1 << 8) | rb2) + (rb2 * blend) - (rb1 * blend)) >> 8) &  TWO_CHANNEL_MASK; // blend red and blue
+  uint32_t wg3 = ((((wg1 << 8) | wg2) + (wg2 * blend) - (wg1 * blend)))      & ~TWO_CHANNEL_MASK; // negated mask for white and green
+  return rb3 | wg3;
+}
+
+/*
+ * color add function that preserves ratio
+ * original idea: https://github.com/wled-dev/WLED/pull/2465 by https://github.com/Proto-molecule
+ * speed optimisations by @dedehai
+ */
+uint32_t color_add(uint32_t c1, uint32_t c2, bool preserveCR)
+{
+  if (c1 == BLACK) return c2;
+  if (c2 == BLACK) return c1;
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF; // mask for R and B channels or W and G if negated
+  uint32_t rb = ( c1     & TWO_CHANNEL_MASK) + ( c2     & TWO_CHANNEL_MASK); // mask and add two colors at once
+  uint32_t wg = ((c1>>8) & TWO_CHANNEL_MASK) + ((c2>>8) & TWO_CHANNEL_MASK);
+  uint32_t r = rb >> 16; // extract single color values
+  uint32_t b = rb & 0xFFFF;
+  uint32_t w = wg >> 16;
+  uint32_t g = wg & 0xFFFF;
+
+  if (preserveCR) { // preserve color ratios
+    uint32_t max = std::max(r,g); // check for overflow note
+    max = std::max(max,b);
+    max = std::max(max,w);
+    //unsigned max = r; // check for overflow note
+    //max = g > max ? g : max;
+    //max = b > max ? b : max;
+    //max = w > max ? w : max;
+    if (max > 255) {
+      const uint32_t scale = (uint32_t(255)<<8) / max; // division of two 8bit (shifted) values does not work -> use bit shifts and multiplaction instead
+      rb = ((rb * scale) >> 8) &  TWO_CHANNEL_MASK;
+      wg =  (wg * scale)       & ~TWO_CHANNEL_MASK;
+    } else wg <<= 8; //shift white and green back to correct position
+    return rb | wg;
+  } else {
+    r = r > 255 ? 255 : r;
+    g = g > 255 ? 255 : g;
+    b = b > 255 ? 255 : b;
+    w = w > 255 ? 255 : w;
+    return RGBW32(r,g,b,w);
+  }
+}
+
+/*
+ * fades color toward black
+ * if using "video" method the resulting color will never become black unless it is already black
+ */
+
+uint32_t color_fade(uint32_t c1, uint8_t amount, bool video)
+{
+  if (amount == 255) return c1;
+  if (c1 == BLACK || amount == 0) return BLACK;
+  uint32_t scaledcolor; // color order is: W R G B from MSB to LSB
+  uint32_t scale = amount; // 32bit for faster calculation
+  uint32_t addRemains = 0;
+  if (!video) scale++; // add one for correct scaling using bitshifts
+  else { // video scaling: make sure colors do not dim to zero if they started non-zero
+    addRemains  = R(c1) ? 0x00010000 : 0;
+    addRemains |= G(c1) ? 0x00000100 : 0;
+    addRemains |= B(c1) ? 0x00000001 : 0;
+    addRemains |= W(c1) ? 0x01000000 : 0;
+  }
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
+  uint32_t rb = (((c1 & TWO_CHANNEL_MASK) * scale) >> 8) &  TWO_CHANNEL_MASK; // scale red and blue
+  uint32_t wg = (((c1 >> 8) & TWO_CHANNEL_MASK) * scale) & ~TWO_CHANNEL_MASK; // scale white and green
+  scaledcolor = (rb | wg) + addRemains;
+  return scaledcolor;
+}
+
+/*
+ * array versions of color_fade(), color_blend() and color_add() operating on raw pixel buffers
+ * results are identical to calling the single pixel functions for each pixel, but loop invariant parts
+ * are calculated once and per-pixel branches are replaced by bit manipulation (two channels per 32bit operation)
+ */
+void fadePixels(uint32_t *pixels, unsigned length, uint8_t amount, bool video) {
+  if (amount == 255) return;
+  if (amount == 0) { memset(pixels, 0, length * sizeof(uint32_t)); return; }
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
+  const uint32_t scale = video ? amount : amount + 1;
+  for (unsigned i = 0; i < length; i++) {
+    const uint32_t c = pixels[i];
+    uint32_t rb = (((c & TWO_CHANNEL_MASK) * scale) >> 8) &  TWO_CHANNEL_MASK; // scale red and blue
+    uint32_t wg = (((c >> 8) & TWO_CHANNEL_MASK) * scale) & ~TWO_CHANNEL_MASK; // scale white and green
+    uint32_t addRemains = 0;
+    if (video) { // set lowest bit of each non-zero channel (black stays black)
+      addRemains = (((c & 0x7F7F7F7F) + 0x7F7F7F7F) | c) & 0x80808080;
+      addRemains >>= 7;
+    }
+    pixels[i] = (rb | wg) + addRemains;
+  }
+}
+
+// blend all pixels towards a color
+void blendPixels(uint32_t *pixels, unsigned length, uint32_t color, uint8_t blend) {
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
+  const uint32_t keep = 256 - blend;
+  // (c1 << 8 | c2) + c2 * blend - c1 * blend == c1 * (256 - blend) + c2 * (blend + 1) (modulo 2^32)
+  const uint32_t rb2 =  (color       & TWO_CHANNEL_MASK) * (blend + 1);
+  const uint32_t wg2 = ((color >> 8) & TWO_CHANNEL_MASK) * (blend + 1);
+  for (unsigned i = 0; i < length; i++) {
+    const uint32_t c = pixels[i];
+    uint32_t rb = ((( c       & TWO_CHANNEL_MASK) * keep + rb2) >> 8) &  TWO_CHANNEL_MASK;
+    uint32_t wg =  (((c >> 8) & TWO_CHANNEL_MASK) * keep + wg2)       & ~TWO_CHANNEL_MASK;
+    pixels[i] = rb | wg;
+  }
+}
+
+// blend pixels of another buffer into pixels (same as pixels[i] = color_blend(pixels[i], src[i], blend))
+void blendPixels(uint32_t *pixels, const uint32_t *src, unsigned length, uint8_t blend) {
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
+  const uint32_t keep = 256 - blend;
+  const uint32_t take = blend + 1;
+  for (unsigned i = 0; i < length; i++) {
+    const uint32_t c1 = pixels[i];
+    const uint32_t c2 = src[i];
+    uint32_t rb = ((( c1       & TWO_CHANNEL_MASK) * keep + ( c2       & TWO_CHANNEL_MASK) * take) >> 8) &  TWO_CHANNEL_MASK;
+    uint32_t wg =  (((c1 >> 8) & TWO_CHANNEL_MASK) * keep + ((c2 >> 8) & TWO_CHANNEL_MASK) * take)       & ~TWO_CHANNEL_MASK;
+    pixels[i] = rb | wg;
+  }
+}
+
+// add a color to all pixels
+void addPixels(uint32_t *pixels, unsigned length, uint32_t color, bool preserveCR) {
+  if (color == BLACK) return;
+  if (preserveCR) {
+    for (unsigned i = 0; i < length; i++) pixels[i] = color_add(pixels[i], color, true);
+    return;
+  }
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
+  const uint32_t rb2 =  color       & TWO_CHANNEL_MASK;
+  const uint32_t wg2 = (color >> 8) & TWO_CHANNEL_MASK;
+  for (unsigned i = 0; i < length; i++) {
+    const uint32_t c = pixels[i];
+    uint32_t rb = ( c       & TWO_CHANNEL_MASK) + rb2;
+    uint32_t wg = ((c >> 8) & TWO_CHANNEL_MASK) + wg2;
+    rb |= ((rb >> 8) & 0x00010001) * 0xFF; // saturate channels that overflowed
+    wg |= ((wg >> 8) & 0x00010001) * 0xFF;
+    pixels[i] = (rb & TWO_CHANNEL_MASK) | ((wg & TWO_CHANNEL_MASK) << 8);
+  }
+}
+
+/*
+ * blur functions operating on raw pixel buffers, algorithm from FastLED blur1d()/blur2d()
+ * each pixel keeps 255-blur of its value (all of it if smearing) and gets blur/2 from both of its neighbours
+ * note: kept in this file so color_fade() and color_add() can be inlined
+ */
+void blurPixelLine(uint32_t *pixels, unsigned length, uint8_t blur, bool smear) {
+  if (length == 0) return;
+  const uint8_t keep = smear ? 255 : 255 - blur;
+  const uint8_t seep = blur >> 1;
+  uint32_t carryover = BLACK;
+  uint32_t lastnew = BLACK;
+  for (unsigned i = 0; i < length; i++) {
+    uint32_t cur = pixels[i];
+    uint32_t part = color_fade(cur, seep);
+    uint32_t curnew = color_fade(cur, keep);
+    if (carryover) curnew = color_add(curnew, carryover);
+    if (i > 0) pixels[i - 1] = color_add(lastnew, part);
+    lastnew = curnew;
+    carryover = part;
+  }
+  pixels[length - 1] = lastnew;
+}
+
+// blur all rows of a cols x rows buffer
+void blurPixelRows(uint32_t *pixels, unsigned cols, unsigned rows, uint8_t blur, bool smear) {
+  for (unsigned row = 0; row < rows; row++) blurPixelLine(pixels + row * cols, cols, blur, smear);
+}
+
+// blur all columns of a cols x rows buffer
+// columns are processed in blocks walking down the rows, so memory is accessed in contiguous chunks instead of one pixel per row
+void blurPixelColumns(uint32_t *pixels, unsigned cols, unsigned rows, uint8_t blur, bool smear) {
+  if (rows == 0) return;
+  constexpr unsigned BLOCK = 8;
+  const uint8_t keep = smear ? 255 : 255 - blur;
+  const uint8_t seep = blur >> 1;
+  uint32_t carryover[BLOCK];
+  uint32_t lastnew[BLOCK];
+  for (unsigned col = 0; col < cols; col += BLOCK) {
+    const unsigned n = std::min(BLOCK, cols - col);
+    memset(carryover, 0, sizeof(carryover));
+    uint32_t *row = pixels + col;
+    for (unsigned y = 0; y < rows; y++, row += cols) {
+      for (unsigned c = 0; c < n; c++) {
+        uint32_t cur = row[c];
+        uint32_t part = color_fade(cur, seep);
+        uint32_t curnew = color_fade(cur, keep);
+        if (carryover[c]) curnew = color_add(curnew, carryover[c]);
+        if (y > 0) (row - cols)[c] = color_add(lastnew[c], part);
+        lastnew[c] = curnew;
+        carryover[c] = part;
+      }
+    }
+    row -= cols; // last row
+    for (unsigned c = 0; c < n; c++) row[c] = lastnew[c];
+  }
+}
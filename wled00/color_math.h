@@ -0,0 +1,23 @@
+#pragma once
+#ifndef WLED_COLOR_MATH_H
+#define WLED_COLOR_MATH_H
+
+/*
+ * Color math on packed 32bit WRGB values and raw pixel buffers (color_math.cpp)
+ */
+
+#include <stdint.h>
+
+[[gnu::hot, gnu::pure]] uint32_t color_blend(uint32_t c1, uint32_t c2 , uint8_t blend);
+inline uint32_t color_blend16(uint32_t c1, uint32_t c2, uint16_t b) { return color_blend(c1, c2, b >> 8); };
+[[gnu::hot, gnu::pure]] uint32_t color_add(uint32_t, uint32_t, bool preserveCR = false);
+[[gnu::hot, gnu::pure]] uint32_t color_fade(uint32_t c1, uint8_t amount, bool video=false);
+[[gnu::hot]] void fadePixels(uint32_t *pixels, unsigned length, uint8_t amount, bool video = false);
+[[gnu::hot]] void blendPixels(uint32_t *pixels, unsigned length, uint32_t color, uint8_t blend);
+[[gnu::hot]] void blendPixels(uint32_t *pixels, const uint32_t *src, unsigned length, uint8_t blend);
+[[gnu::hot]] void addPixels(uint32_t *pixels, unsigned length, uint32_t color, bool preserveCR = false);
+[[gnu::hot]] void blurPixelLine(uint32_t *pixels, unsigned length, uint8_t blur, bool smear = false);
+[[gnu::hot]] void blurPixelRows(uint32_t *pixels, unsigned cols, unsigned rows, uint8_t blur, bool smear = false);
+[[gnu::hot]] void blurPixelColumns(uint32_t *pixels, unsigned cols, unsigned rows, uint8_t blur, bool smear = false);
+
+#endif
@@ -4,88 +4,6 @@
  * Color conversion & utility methods
  */
 
-/*
- * color blend function, based on FastLED blend function
- * the calculation for each color is: result = (A*(amountOfA) + A + B*(amountOfB) + B) / 256 with amountOfA = 255 - amountOfB
- */
-uint32_t color_blend(uint32_t color1, uint32_t color2, uint8_t blend) {
-  // min / max blend checking is omitted: calls with 0 or 255 are rare, checking lowers overall performance
-  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;     // mask for R and B channels or W and G if negated (poorman's SIMD; https://github.com/wled/WLED/pull/4568#discussion_r1986587221)
-  uint32_t rb1 =  color1       & TWO_CHANNEL_MASK;  // extract R & B channels from color1
-  uint32_t wg1 = (color1 >> 8) & TWO_CHANNEL_MASK;  // extract W & G channels from color1 (shifted for multiplication later)
-  uint32_t rb2 =  color2       & TWO_CHANNEL_MASK;  // extract R & B channels from color2
-  uint32_t wg2 = (color2 >> 8) & TWO_CHANNEL_MASK;  // extract W & G channels from color2 (shifted for multiplication later)
-  uint32_t rb3 = ((((rb1 << 8) | rb2) + (rb2 * blend) - (rb1 * blend)) >> 8) &  TWO_CHANNEL_MASK; // blend red and blue
-  uint32_t wg3 = ((((wg1 << 8) | wg2) + (wg2 * blend) - (wg1 * blend)))      & ~TWO_CHANNEL_MASK; // negated mask for white and green
-  return rb3 | wg3;
-}
-
-/*
- * color add function that preserves ratio
- * original idea: https://github.com/wled-dev/WLED/pull/2465 by https://github.com/Proto-molecule
- * speed optimisations by @dedehai
- */
-uint32_t color_add(uint32_t c1, uint32_t c2, bool preserveCR)
-{
-  if (c1 == BLACK) return c2;
-  if (c2 == BLACK) return c1;
-  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF; // mask for R and B channels or W and G if negated
-  uint32_t rb = ( c1     & TWO_CHANNEL_MASK) + ( c2     & TWO_CHANNEL_MASK); // mask and add two colors at once
-  uint32_t wg = ((c1>>8) & TWO_CHANNEL_MASK) + ((c2>>8) & TWO_CHANNEL_MASK);
-  uint32_t r = rb >> 16; // extract single color values
-  uint32_t b = rb & 0xFFFF;
-  uint32_t w = wg >> 16;
-  uint32_t g = wg & 0xFFFF;
-
-  if (preserveCR) { // preserve color ratios
-    uint32_t max = std::max(r,g); // check for overflow note
-    max = std::max(max,b);
-    max = std::max(max,w);
-    //unsigned max = r; // check for overflow note
-    //max = g > max ? g : max;
-    //max = b > max ? b : max;
-    //max = w > max ? w : max;
-    if (max > 255) {
-      const uint32_t scale = (uint32_t(255)<<8) / max; // division of two 8bit (shifted) values does not work -> use bit shifts and multiplaction instead
-      rb = ((rb * scale) >> 8) &  TWO_CHANNEL_MASK;
-      wg =  (wg * scale)       & ~TWO_CHANNEL_MASK;
-    } else wg <<= 8; //shift white and green back to correct position
-    return rb | wg;
-  } else {
-    r = r > 255 ? 255 : r;
-    g = g > 255 ? 255 : g;
-    b = b > 255 ? 255 : b;
-    w = w > 255 ? 255 : w;
-    return RGBW32(r,g,b,w);
-  }
-}
-
-/*
- * fades color toward black
- * if using "video" method the resulting color will never become black unless it is already black
- */
-
-uint32_t color_fade(uint32_t c1, uint8_t amount, bool video)
-{
-  if (amount == 255) return c1;
-  if (c1 == BLACK || amount == 0) return BLACK;
-  uint32_t scaledcolor; // color order is: W R G B from MSB to LSB
-  uint32_t scale = amount; // 32bit for faster calculation
-  uint32_t addRemains = 0;
-  if (!video) scale++; // add one for correct scaling using bitshifts
-  else { // video scaling: make sure colors do not dim to zero if they started non-zero
-    addRemains  = R(c1) ? 0x00010000 : 0;
-    addRemains |= G(c1) ? 0x00000100 : 0;
-    addRemains |= B(c1) ? 0x00000001 : 0;
-    addRemains |= W(c1) ? 0x01000000 : 0;
-  }
-  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
-  uint32_t rb = (((c1 & TWO_CHANNEL_MASK) * scale) >> 8) &  TWO_CHANNEL_MASK; // scale red and blue
-  uint32_t wg = (((c1 >> 8) & TWO_CHANNEL_MASK) * scale) & ~TWO_CHANNEL_MASK; // scale white and green
-  scaledcolor = (rb | wg) + addRemains;
-  return scaledcolor;
-}
-
 /*
  * color adjustment in HSV color space (converts RGB to HSV and back), color conversions are not 100% accurate!
    shifts hue, increase brightness, decreases saturation (if not black)
@@ -249,10 +167,40 @@ CRGBPalette16 generateRandomPalette()  // generate fully random palette
                        CHSV(hw_random8(), hw_random8(160, 255), hw_random8(128, 255)));
 }
 
+#ifdef WLED_ENABLE_BOOT_SNAPSHOT
+static const char s_pal_snap[] PROGMEM = "/palettes.snap";
+
+// combined checksum of all custom palette files
+static uint32_t customPalettesChecksum() {
+  uint16_t crc = 0xFFFF;
+  unsigned files = 0;
+  for (; files < 10; files++) {
+    char fileName[32];
+    sprintf_P(fileName, PSTR("/palette%d.json"), files);
+    if (!WLED_FS.exists(fileName)) break;
+    uint32_t checksum = fileChecksum(fileName);
+    crc = crc16((const unsigned char*)&checksum, sizeof(checksum), crc);
+  }
+  return files ? ((uint32_t)crc << 16) | files : 0;
+}
+#endif
+
 void loadCustomPalettes() {
   byte tcp[72]; //support gradient palettes with up to 18 entries
   CRGBPalette16 targetPalette;
   customPalettes.clear(); // start fresh
+  #ifdef WLED_ENABLE_BOOT_SNAPSHOT
+  // palettes are stored as CRGBPalette16 in snapshot so JSON parsing is only needed if palette files changed
+  uint32_t checksum = customPalettesChecksum();
+  File snap = openSnapshot(s_pal_snap, checksum);
+  if (snap) {
+    while (customPalettes.size() < 10 && snap.read((uint8_t*)&targetPalette, sizeof(targetPalette)) == sizeof(targetPalette)) customPalettes.push_back(targetPalette);
+    snap.close();
+    bootSnapshot |= BOOT_SNAPSHOT_PALETTES;
+    invalidateJsonCache(); // palette previews (/json/palx) have changed
+    return;
+  }
+  #endif
   for (int index = 0; index<10; index++) {
     char fileName[32];
     sprintf_P(fileName, PSTR("/palette%d.json"), index);
@@ -295,6 +243,12 @@ void loadCustomPalettes() {
       break;
     }
   }
+  #ifdef WLED_ENABLE_BOOT_SNAPSHOT
+  snap = createSnapshot(s_pal_snap, checksum);
+  if (snap) for (const CRGBPalette16 &pal : customPalettes) snap.write((const uint8_t*)&pal, sizeof(pal));
+  snap.close();
+  #endif
+  invalidateJsonCache(); // palette previews (/json/palx) have changed
 }
 
 void hsv2rgb(const CHSV32& hsv, uint32_t& rgb) // convert HSV (16bit hue) to RGB (32bit with white = 0)
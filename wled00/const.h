@@ -483,6 +483,30 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
 #define MAX_LEDS_PER_BUS 2048   // may not be enough for fast LEDs (i.e. APA102)
 #endif
 
+// keep pre-serialized /json/eff, /json/fxdata and /json/palx responses in (PS)RAM (too large for ESP8266 heap)
+#if !defined(ESP8266) && !defined(WLED_DISABLE_JSON_CACHE)
+  #define WLED_ENABLE_JSON_CACHE
+#endif
+
+// store parsed cfg.json and custom palettes in binary snapshots so warm boots skip JSON parsing
+#if !defined(ESP8266) && !defined(WLED_DISABLE_BOOT_SNAPSHOT)
+  #define WLED_ENABLE_BOOT_SNAPSHOT
+#endif
+#define BOOT_SNAPSHOT_CFG      0x01
+#define BOOT_SNAPSHOT_PALETTES 0x02
+
+// boot phases timed during setup() (reported in /json/info "boot")
+#define BOOT_PHASE_FS        0  // mounting file system
+#define BOOT_PHASE_CFG       1  // reading cfg.json
+#define BOOT_PHASE_PALETTES  2  // loading custom palettes
+#define BOOT_PHASE_LEDMAP    3  // loading ledmap/setting up matrix
+#define BOOT_PHASE_STRIP     4  // beginStrip() (includes palettes and ledmap)
+#define BOOT_PHASE_USERMODS  5  // usermod setup
+#define BOOT_PHASE_SERVER    6  // web server init
+#define BOOT_PHASE_LIGHT     7  // time since reset when strip was initialised
+#define BOOT_PHASE_TOTAL     8  // time since reset when setup() finished
+#define BOOT_PHASES          9
+
 // string temp buffer (now stored in stack locally)
 #ifdef ESP8266
 #define SETTINGS_STACK_BUF_SIZE 2560
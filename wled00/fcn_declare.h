@@ -170,10 +170,7 @@ class NeoGammaWLEDMethod {
 #define gamma8(c)  NeoGammaWLEDMethod::rawGamma8(c)
 #define gamma32inv(c) NeoGammaWLEDMethod::inverseGamma32(c)
 #define gamma8inv(c)  NeoGammaWLEDMethod::rawInverseGamma8(c)
-[[gnu::hot, gnu::pure]] uint32_t color_blend(uint32_t c1, uint32_t c2 , uint8_t blend);
-inline uint32_t color_blend16(uint32_t c1, uint32_t c2, uint16_t b) { return color_blend(c1, c2, b >> 8); };
-[[gnu::hot, gnu::pure]] uint32_t color_add(uint32_t, uint32_t, bool preserveCR = false);
-[[gnu::hot, gnu::pure]] uint32_t color_fade(uint32_t c1, uint8_t amount, bool video=false);
+#include "color_math.h" // color_blend(), color_add(), color_fade() and raw pixel buffer functions
 [[gnu::hot, gnu::pure]] uint32_t adjust_color(uint32_t rgb, uint32_t hueShift, uint32_t lighten, uint32_t brighten);
 [[gnu::hot, gnu::pure]] uint32_t ColorFromPaletteWLED(const CRGBPalette16 &pal, unsigned index, uint8_t brightness = (uint8_t)255U, TBlendType blendType = LINEARBLEND);
 CRGBPalette16 generateHarmonicRandomPalette(const CRGBPalette16 &basepalette);
@@ -213,11 +210,18 @@ void sendArtnetPollReply(ArtPollReply* reply, IPAddress ipAddress, uint16_t port
 
 //file.cpp
 bool handleFileRead(AsyncWebServerRequest*, String path);
-bool writeObjectToFileUsingId(const char* file, uint16_t id, const JsonDocument* content);
-bool writeObjectToFile(const char* file, const char* key, const JsonDocument* content);
+bool writeObjectToFileUsingId(const char* file, uint16_t id, const JsonDocument* content, size_t *objPos = nullptr);
+bool writeObjectToFile(const char* file, const char* key, const JsonDocument* content, size_t *objPos = nullptr);
 bool readObjectFromFileUsingId(const char* file, uint16_t id, JsonDocument* dest, const JsonDocument* filter = nullptr);
 bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest, const JsonDocument* filter = nullptr);
+bool readObjectFromFileAt(const char* file, const char* key, size_t pos, JsonDocument* dest, const JsonDocument* filter = nullptr);
 void updateFSInfo();
+uint32_t fileChecksum(const char* fileName);
+void initFileCache();
+void invalidateFileCache(const char* path = nullptr);
+void serializeFileCacheInfo(JsonObject root);
+File openSnapshot(const char* fileName, uint32_t checksum);
+File createSnapshot(const char* fileName, uint32_t checksum);
 void closeFile();
 inline bool writeObjectToFileUsingId(const String &file, uint16_t id, const JsonDocument* content) { return writeObjectToFileUsingId(file.c_str(), id, content); };
 inline bool writeObjectToFile(const String &file, const char* key, const JsonDocument* content) { return writeObjectToFile(file.c_str(), key, content); };
@@ -241,6 +245,7 @@ int fileReadCallback(void);
 int fileReadBlockCallback(void * buffer, int numberOfBytes);
 int fileSizeCallback(void);
 byte renderImageToSegment(Segment &seg);
+void prefetchVideoFrames();
 void endImagePlayback(Segment* seg);
 #endif
 
@@ -277,6 +282,7 @@ void serializeInfo(JsonObject root);
 void serializeModeNames(JsonArray arr);
 void serializeModeData(JsonArray fxdata);
 void serveJson(AsyncWebServerRequest* request);
+void invalidateJsonCache();
 #ifdef WLED_ENABLE_JSONLIVE
 bool serveLiveLeds(AsyncWebServerRequest* request, uint32_t wsClient = 0);
 #endif
@@ -339,12 +345,15 @@ void initPresetsFile();
 void handlePresets();
 bool applyPreset(byte index, byte callMode = CALL_MODE_DIRECT_CHANGE);
 bool applyPresetFromPlaylist(byte index);
+void prefetchPreset(byte index);
 void applyPresetWithFallback(uint8_t presetID, uint8_t callMode, uint8_t effectID = 0, uint8_t paletteID = 0);
 inline bool applyTemporaryPreset() {return applyPreset(255);};
 void savePreset(byte index, const char* pname = nullptr, JsonObject saveobj = JsonObject());
 inline void saveTemporaryPreset() {savePreset(255);};
 void deletePreset(byte index);
 bool getPresetName(byte index, String& name);
+void invalidatePresetIndex();
+bool servePresetsFile(AsyncWebServerRequest *request);
 
 //remote.cpp
 void handleWiZdata(uint8_t *incomingData, size_t len);
@@ -514,24 +523,16 @@ uint8_t extractModeName(uint8_t mode, const char *src, char *dest, uint8_t maxLe
 uint8_t extractModeSlider(uint8_t mode, uint8_t slider, char *dest, uint8_t maxLen, uint8_t *var = nullptr);
 int16_t extractModeDefaults(uint8_t mode, const char *segVar);
 void checkSettingsPIN(const char *pin);
-uint16_t crc16(const unsigned char* data_p, size_t length);
+uint16_t crc16(const unsigned char* data_p, size_t length, uint16_t crc = 0xFFFF);
 uint16_t beatsin88_t(accum88 beats_per_minute_88, uint16_t lowest = 0, uint16_t highest = 65535, uint32_t timebase = 0, uint16_t phase_offset = 0);
 uint16_t beatsin16_t(accum88 beats_per_minute, uint16_t lowest = 0, uint16_t highest = 65535, uint32_t timebase = 0, uint16_t phase_offset = 0);
 uint8_t beatsin8_t(accum88 beats_per_minute, uint8_t lowest = 0, uint8_t highest = 255, uint32_t timebase = 0, uint8_t phase_offset = 0);
 um_data_t* simulateSound(uint8_t simulationId);
 void enumerateLedmaps();
+void bootPhaseDone(unsigned phase, unsigned long start = 0);
 [[gnu::hot]] uint8_t get_random_wheel_index(uint8_t pos);
 [[gnu::hot, gnu::pure]] float mapf(float x, float in_min, float in_max, float out_min, float out_max);
 uint32_t hashInt(uint32_t s);
-int32_t perlin1D_raw(uint32_t x, bool is16bit = false);
-int32_t perlin2D_raw(uint32_t x, uint32_t y, bool is16bit = false);
-int32_t perlin3D_raw(uint32_t x, uint32_t y, uint32_t z, bool is16bit = false);
-uint16_t perlin16(uint32_t x);
-uint16_t perlin16(uint32_t x, uint32_t y);
-uint16_t perlin16(uint32_t x, uint32_t y, uint32_t z);
-uint8_t perlin8(uint16_t x);
-uint8_t perlin8(uint16_t x, uint16_t y);
-uint8_t perlin8(uint16_t x, uint16_t y, uint16_t z);
 
 // fast (true) random numbers using hardware RNG, all functions return values in the range lowerlimit to upperlimit-1
 // note: for true random numbers with high entropy, do not call faster than every 200ns (5MHz)
@@ -605,38 +606,8 @@ void clearEEPROM();
 #endif
 
 //wled_math.cpp
-//float cos_t(float phi); // use float math
-//float sin_t(float phi);
-//float tan_t(float x);
-int16_t sin16_t(uint16_t theta);
-int16_t cos16_t(uint16_t theta);
-uint8_t sin8_t(uint8_t theta);
-uint8_t cos8_t(uint8_t theta);
-float sin_approx(float theta); // uses integer math (converted to float), accuracy +/-0.0015 (compared to sinf())
-float cos_approx(float theta);
-float tan_approx(float x);
-float atan2_t(float y, float x);
-float acos_t(float x);
-float asin_t(float x);
-template <typename T> T atan_t(T x);
-float floor_t(float x);
-float fmod_t(float num, float denom);
-uint32_t sqrt32_bw(uint32_t x);
-#define sin_t sin_approx
-#define cos_t cos_approx
-#define tan_t tan_approx
+#include "wled_math.h" // sin16_t(), cos16_t(), ... and perlin noise functions
 
-/*
-#include <math.h>  // standard math functions. use a lot of flash
-#define sin_t sinf
-#define cos_t cosf
-#define tan_t tanf
-#define asin_t asinf
-#define acos_t acosf
-#define atan_t atanf
-#define fmod_t fmodf
-#define floor_t floorf
-*/
 //wled_serial.cpp
 void handleSerial();
 void updateBaudRate(uint32_t rate);
@@ -648,6 +619,8 @@ void serveMessage(AsyncWebServerRequest* request, uint16_t code, const String& h
 void serveJsonError(AsyncWebServerRequest* request, uint16_t code, uint16_t error);
 void serveSettings(AsyncWebServerRequest* request, bool post = false);
 void serveSettingsJS(AsyncWebServerRequest* request);
+void setStaticContentCacheHeaders(AsyncWebServerResponse *response, int code, uint16_t eTagSuffix = 0);
+bool handleIfNoneMatchCacheHeader(AsyncWebServerRequest *request, int code, uint16_t eTagSuffix = 0);
 
 //ws.cpp
 void handleWs();
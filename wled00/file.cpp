@@ -176,7 +176,7 @@ static void writeSpace(size_t l)
   if (knownLargestSpace < l) knownLargestSpace = l;
 }
 
-static bool appendObjectToFile(const char* key, const JsonDocument* content, uint32_t s, uint32_t contentLen = 0)
+static bool appendObjectToFile(const char* key, const JsonDocument* content, uint32_t s, uint32_t contentLen = 0, size_t *objPos = nullptr)
 {
   #ifdef WLED_DEBUG_FS
     DEBUGFS_PRINTLN(F("Append"));
@@ -202,6 +202,7 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
   if (bufferedFindSpace(contentLen + strlen(key) + 1)) {
     if (f.position() > 2) f.write(','); //add comma if not first object
     f.print(key);
+    if (objPos) *objPos = f.position();
     serializeJson(*content, f);
     DEBUGFS_PRINTF("Inserted, took %lu ms (total %lu)", millis() - s1, millis() - s);
     doCloseFile = true;
@@ -245,6 +246,7 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
   }
 
   f.print(key);
+  if (objPos) *objPos = f.position();
 
   //Append object
   serializeJson(*content, f);
@@ -255,16 +257,18 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
   return true;
 }
 
-bool writeObjectToFileUsingId(const char* file, uint16_t id, const JsonDocument* content)
+bool writeObjectToFileUsingId(const char* file, uint16_t id, const JsonDocument* content, size_t *objPos)
 {
   char objKey[10];
   sprintf(objKey, "\"%d\":", id);
-  return writeObjectToFile(file, objKey, content);
+  return writeObjectToFile(file, objKey, content, objPos);
 }
 
-bool writeObjectToFile(const char* file, const char* key, const JsonDocument* content)
+// objPos (optional) receives file position at which the object was written (0 if it was deleted)
+bool writeObjectToFile(const char* file, const char* key, const JsonDocument* content, size_t *objPos)
 {
   uint32_t s = 0; //timing
+  invalidateFileCache(file);
   #ifdef WLED_DEBUG_FS
     DEBUGFS_PRINTF("Write to %s with key %s >>>\n", file, (key==nullptr)?"nullptr":key);
     serializeJson(*content, Serial); DEBUGFS_PRINTLN();
@@ -272,6 +276,7 @@ bool writeObjectToFile(const char* file, const char* key, const JsonDocument* co
   #endif
 
   size_t pos = 0;
+  if (objPos) *objPos = 0;
   char fileName[129]; strncpy_P(fileName, file, 128); fileName[128] = 0; //use PROGMEM safe copy as FS.open() does not
   f = WLED_FS.open(fileName, WLED_FS.exists(fileName) ? "r+" : "w+");
   if (!f) {
@@ -281,7 +286,7 @@ bool writeObjectToFile(const char* file, const char* key, const JsonDocument* co
 
   if (!bufferedFind(key)) //key does not exist in file
   {
-    return appendObjectToFile(key, content, s);
+    return appendObjectToFile(key, content, s, 0, objPos);
   }
 
   //an object with this key already exists, replace or delete it
@@ -305,11 +310,13 @@ bool writeObjectToFile(const char* file, const char* key, const JsonDocument* co
   if (contentLen && contentLen <= oldLen) { //replace and fill diff with spaces
     DEBUGFS_PRINTLN(F("replace"));
     f.seek(pos);
+    if (objPos) *objPos = pos;
     serializeJson(*content, f);
     writeSpace(pos2 - f.position());
   } else if (contentLen && bufferedFindSpace(contentLen - oldLen, false)) { //enough leading spaces to replace
     DEBUGFS_PRINTLN(F("replace (trailing)"));
     f.seek(pos);
+    if (objPos) *objPos = pos;
     serializeJson(*content, f);
   } else {
     DEBUGFS_PRINTLN(F("delete"));
@@ -317,7 +324,7 @@ bool writeObjectToFile(const char* file, const char* key, const JsonDocument* co
     if (pos > 3) pos--; //also delete leading comma if not first object
     f.seek(pos);
     writeSpace(pos2 - pos);
-    if (contentLen) return appendObjectToFile(key, content, s, contentLen);
+    if (contentLen) return appendObjectToFile(key, content, s, contentLen, objPos);
   }
 
   doCloseFile = true;
@@ -360,6 +367,42 @@ bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest, c
   return true;
 }
 
+// reads object whose value starts at a known file position (e.g. taken from an index)
+// the key preceding that position (whitespace between key and value is skipped) is verified, returns false if it does not match
+bool readObjectFromFileAt(const char* file, const char* key, size_t pos, JsonDocument* dest, const JsonDocument* filter)
+{
+  if (doCloseFile) closeFile();
+  #ifdef WLED_DEBUG_FS
+    DEBUGFS_PRINTF("Read from %s with key %s at %u >>>\n", file, key, pos);
+    uint32_t s = millis();
+  #endif
+  size_t keyLen = strlen(key);
+  char fileName[129]; strncpy_P(fileName, file, 128); fileName[128] = 0; //use PROGMEM safe copy as FS.open() does not
+  f = WLED_FS.open(fileName, "r");
+  if (!f) return false;
+
+  char buf[32];
+  size_t end = min(pos, sizeof(buf)); // read key and any whitespace between key and value
+  bool found = keyLen < sizeof(buf) && pos < f.size() && f.seek(pos - end) && f.read((uint8_t*)buf, end) == end;
+  if (found) {
+    while (end > keyLen && (buf[end-1] == ' ' || buf[end-1] == '\t' || buf[end-1] == '\r' || buf[end-1] == '\n')) end--;
+    found = end >= keyLen && strncmp(buf + end - keyLen, key, keyLen) == 0; // file position is at pos again
+  }
+  if (!found) {
+    f.close();
+    dest->clear();
+    DEBUGFS_PRINTLN(F("Key mismatch."));
+    return false;
+  }
+
+  if (filter) deserializeJson(*dest, f, DeserializationOption::Filter(*filter));
+  else        deserializeJson(*dest, f);
+
+  f.close();
+  DEBUGFS_PRINTF("Read, took %lu ms\n", millis() - s);
+  return true;
+}
+
 void updateFSInfo() {
   #ifdef ARDUINO_ARCH_ESP32
     #if WLED_FS == LITTLEFS || ESP_IDF_VERSION_MAJOR >= 4
@@ -377,63 +420,207 @@ void updateFSInfo() {
 }
 
 
+// CRC16 of file content (upper 16 bits) and its size (lower 16 bits), 0 if file does not exist
+uint32_t fileChecksum(const char* fileName) {
+  char name[33]; strncpy_P(name, fileName, 32); name[32] = 0; //use PROGMEM safe copy as FS.open() does not
+  if (doCloseFile) closeFile();
+  File file = WLED_FS.open(name, "r");
+  if (!file) return 0;
+  uint8_t buf[256];
+  size_t len;
+  uint16_t crc = 0xFFFF;
+  while ((len = file.read(buf, sizeof(buf))) > 0) crc = crc16(buf, len, crc);
+  uint32_t checksum = ((uint32_t)crc << 16) | (file.size() & 0xFFFF);
+  file.close();
+  return checksum;
+}
+
+/*
+ * Snapshots hold binary data derived from (JSON) files so it does not need to be parsed again on next boot.
+ * Header contains checksum of the source (see fileChecksum()) and firmware version, a snapshot that does
+ * not match is ignored (and should be recreated by caller).
+ */
+#define SNAPSHOT_MAGIC 0x504E5357UL // "WSNP"
+
+File openSnapshot(const char* fileName, uint32_t checksum) {
+  char name[33]; strncpy_P(name, fileName, 32); name[32] = 0;
+  if (checksum == 0 || !WLED_FS.exists(name)) return File();
+  File file = WLED_FS.open(name, "r");
+  uint32_t hdr[3] = {0, 0, 0};
+  if (file && (file.read((uint8_t*)hdr, sizeof(hdr)) != sizeof(hdr) || hdr[0] != SNAPSHOT_MAGIC || hdr[1] != VERSION || hdr[2] != checksum)) {
+    DEBUGFS_PRINTF("Snapshot %s outdated.\n", name);
+    file.close();
+    return File();
+  }
+  return file;
+}
+
+File createSnapshot(const char* fileName, uint32_t checksum) {
+  char name[33]; strncpy_P(name, fileName, 32); name[32] = 0;
+  if (checksum == 0) return File();
+  File file = WLED_FS.open(name, "w");
+  uint32_t hdr[3] = {SNAPSHOT_MAGIC, VERSION, checksum};
+  if (file) file.write((const uint8_t*)hdr, sizeof(hdr));
+  return file;
+}
+
 #ifdef ARDUINO_ARCH_ESP32
-// caching presets in PSRAM may prevent occasional flashes seen when HomeAssitant polls WLED
-// original idea by @akaricchi (https://github.com/Akaricchi)
-// returns a pointer to the PSRAM buffer, updates size parameter
-static const uint8_t *getPresetCache(size_t &size) {
-  static unsigned long presetsCachedTime = 0;
-  static uint8_t *presetsCached = nullptr;
-  static size_t presetsCachedSize = 0;
-  static byte presetsCachedValidate = 0;
-
-  //if (presetsModifiedTime != presetsCachedTime) DEBUG_PRINTLN(F("getPresetCache(): presetsModifiedTime changed."));
-  //if (presetsCachedValidate != cacheInvalidate) DEBUG_PRINTLN(F("getPresetCache(): cacheInvalidate changed."));
-
-  if ((presetsModifiedTime != presetsCachedTime) || (presetsCachedValidate != cacheInvalidate)) {
-    if (presetsCached) {
-      p_free(presetsCached);
-      presetsCached = nullptr;
-    }
+/*
+ * File cache
+ * Files served by handleFileRead() are kept in PSRAM (LRU, up to FILE_CACHE_SIZE) so that page loads and polling
+ * (i.e. HomeAssistant reading presets.json, which may cause occasional flashes) do not access the file system.
+ * Original idea (presets.json only) by @akaricchi (https://github.com/Akaricchi)
+ * Entries are dropped on upload (cacheInvalidate), when written using writeObjectToFile(), the /edit handler or
+ * invalidateFileCache() and presets.json also when presets are modified. Data is reference counted so a response that is still being sent
+ * is not affected by eviction.
+ */
+#ifndef FILE_CACHE_SIZE
+#define FILE_CACHE_SIZE (512*1024)
+#endif
+#define FILE_CACHE_MAX_FILE (FILE_CACHE_SIZE/2)
+
+typedef struct FileCacheEntry {
+  String path;                    // requested path (without .gz)
+  String contentType;
+  std::shared_ptr<uint8_t> data;
+  size_t len;
+  uint32_t lastUsed;              // LRU counter
+  uint16_t eTag;                  // CRC16 of content
+  bool gzip;                      // content of path.gz
+} file_cache_t;
+
+static std::vector<FileCacheEntry> fileCache;
+static SemaphoreHandle_t fileCacheMutex = nullptr; // requests are served from async_tcp task, writes happen in loop
+static size_t   fileCacheSize = 0;
+static uint32_t fileCacheUse = 0, fileCacheHits = 0, fileCacheMisses = 0;
+static byte     fileCacheValidFor = 0;             // cacheInvalidate value cache content is valid for
+static unsigned long presetsCachedTime = 0;         // presetsModifiedTime when presets.json was cached
+
+void initFileCache() {
+  if (!fileCacheMutex) fileCacheMutex = xSemaphoreCreateMutex();
+}
+
+void invalidateFileCache(const char* path) {
+  if (!fileCacheMutex) return; // initFileCache() was not called yet, nothing is cached
+  char name[33] = {0};
+  if (path) { strncpy_P(name, path, 32); name[32] = 0; } //use PROGMEM safe copy
+  size_t nameLen = strlen(name);
+  if (nameLen > 3 && strcmp(name + nameLen - 3, ".gz") == 0) name[nameLen - 3] = 0;
+  xSemaphoreTake(fileCacheMutex, portMAX_DELAY);
+  for (auto it = fileCache.begin(); it != fileCache.end();) {
+    if (!path || it->path.equals(name)) {
+      fileCacheSize -= it->len;
+      it = fileCache.erase(it);
+    } else ++it;
   }
+  xSemaphoreGive(fileCacheMutex);
+}
 
-  if (!presetsCached) {
-    File file = WLED_FS.open(FPSTR(getPresetsFileName()), "r");
-    if (file) {
-      presetsCachedTime = presetsModifiedTime;
-      presetsCachedValidate = cacheInvalidate;
-      presetsCachedSize = 0;
-      presetsCached = (uint8_t*)p_malloc(file.size() + 1);
-      if (presetsCached) {
-        presetsCachedSize = file.size();
-        file.read(presetsCached, presetsCachedSize);
-        presetsCached[presetsCachedSize] = 0;
-        file.close();
-      }
-    }
+void serializeFileCacheInfo(JsonObject root) {
+  if (!fileCacheMutex) return;
+  xSemaphoreTake(fileCacheMutex, portMAX_DELAY);
+  size_t n = fileCache.size(), size = fileCacheSize;
+  xSemaphoreGive(fileCacheMutex);
+  JsonObject cache = root.createNestedObject(F("fcache"));
+  cache[F("n")]    = n;
+  cache[F("size")] = size;
+  cache[F("hit")]  = fileCacheHits;
+  cache[F("miss")] = fileCacheMisses;
+}
+
+// content type the web server library sends for a file (AsyncFileResponse maps the extension if no type is given)
+class FileContentType : public AsyncFileResponse {
+  public:
+    FileContentType(File &file, const String &path) : AsyncFileResponse(file, path) {}
+    const String &get() const { return _contentType; }
+};
+
+// returns copy of cache entry (loading file if needed), entry.data is empty if file can't be cached
+static FileCacheEntry getCachedFile(const String &path) {
+  FileCacheEntry entry = {path, String(), nullptr, 0, 0, 0, false};
+  if (!fileCacheMutex) return entry;
+  if (fileCacheValidFor != cacheInvalidate) {
+    invalidateFileCache(nullptr);
+    fileCacheValidFor = cacheInvalidate;
+  }
+  if (presetsModifiedTime != presetsCachedTime && path.endsWith(FPSTR(getPresetsFileName()))) {
+    invalidateFileCache(getPresetsFileName());
+    presetsCachedTime = presetsModifiedTime;
+  }
+
+  xSemaphoreTake(fileCacheMutex, portMAX_DELAY);
+  for (auto &e : fileCache) if (e.path == path) {
+    e.lastUsed = ++fileCacheUse;
+    fileCacheHits++;
+    entry = e;
+    break;
+  }
+  xSemaphoreGive(fileCacheMutex);
+  if (entry.data) return entry;
+
+  fileCacheMisses++;
+  entry.gzip = WLED_FS.exists(path + ".gz"); // .gz takes precedence over the plain file
+  File file = WLED_FS.open(entry.gzip ? path + ".gz" : path, "r");
+  if (!file || file.isDirectory() || file.size() == 0 || file.size() > FILE_CACHE_MAX_FILE) return entry;
+  size_t len = file.size();
+  uint8_t *buf = static_cast<uint8_t*>(p_malloc(len));
+  if (!buf) return entry;
+  if (file.read(buf, len) != len) {
+    p_free(buf);
+    return entry;
+  }
+  entry.contentType = FileContentType(file, path).get(); // closes file
+  entry.data = std::shared_ptr<uint8_t>(buf, [](uint8_t *p) { p_free(p); });
+  entry.len  = len;
+  entry.eTag = crc16(buf, len);
+
+  xSemaphoreTake(fileCacheMutex, portMAX_DELAY);
+  while (!fileCache.empty() && fileCacheSize + len > FILE_CACHE_SIZE) { // evict least recently used
+    auto lru = std::min_element(fileCache.begin(), fileCache.end(), [](const FileCacheEntry &a, const FileCacheEntry &b) { return a.lastUsed < b.lastUsed; });
+    fileCacheSize -= lru->len;
+    fileCache.erase(lru);
   }
+  entry.lastUsed = ++fileCacheUse;
+  fileCache.push_back(entry);
+  fileCacheSize += len;
+  xSemaphoreGive(fileCacheMutex);
+  DEBUGFS_PRINTF("File cache: %s, %u bytes\n", path.c_str(), len);
+  return entry;
+}
 
-  size = presetsCachedSize;
-  return presetsCached;
+static bool serveCachedFile(AsyncWebServerRequest* request, const String &path) {
+  FileCacheEntry entry = getCachedFile(path);
+  if (!entry.data) return false;
+  if (handleIfNoneMatchCacheHeader(request, 200, entry.eTag)) return true;
+  std::shared_ptr<uint8_t> data = entry.data;
+  size_t len = entry.len;
+  AsyncWebServerResponse *response = request->beginResponse(entry.contentType, len,
+    [data, len](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+      size_t n = std::min(maxLen, len - index);
+      memcpy(buffer, data.get() + index, n);
+      return n;
+    });
+  if (entry.gzip) response->addHeader(F("Content-Encoding"), F("gzip"));
+  if (request->hasArg(F("download"))) response->addHeader(F("Content-Disposition"), String(F("attachment; filename=\"")) + path.substring(path.lastIndexOf('/') + 1) + '"');
+  setStaticContentCacheHeaders(response, 200, entry.eTag);
+  request->send(response);
+  return true;
 }
+#else
+void initFileCache() {}
+void invalidateFileCache(const char*) {}
+void serializeFileCacheInfo(JsonObject) {}
 #endif
 
 bool handleFileRead(AsyncWebServerRequest* request, String path){
   DEBUGFS_PRINT(F("WS FileRead: ")); DEBUGFS_PRINTLN(path);
   if(path.endsWith("/")) path += "index.htm";
   if(path.indexOf(F("sec")) > -1) return false;
-  #ifdef ARDUINO_ARCH_ESP32
-  if (psramSafe && psramFound() && path.endsWith(FPSTR(getPresetsFileName()))) {
-    size_t psize;
-    const uint8_t *presets = getPresetCache(psize);
-    if (presets) {
-      AsyncWebServerResponse *response = request->beginResponse_P(200, FPSTR(CONTENT_TYPE_JSON), presets, psize);
-      request->send(response);
-      return true;
-    }
-  }
-  #endif
+  if (path.endsWith(FPSTR(getPresetsFileName())) && servePresetsFile(request)) return true; // merged with pending preset journal
   if(WLED_FS.exists(path) || WLED_FS.exists(path + ".gz")) {
+    #ifdef ARDUINO_ARCH_ESP32
+    if (psramSafe && psramFound() && serveCachedFile(request, path)) return true;
+    #endif
     request->send(request->beginResponse(WLED_FS, path, {}, request->hasArg(F("download")), {}));
     return true;
   }
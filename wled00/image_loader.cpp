@@ -7,15 +7,31 @@
 
 /*
  * Functions to render images from filesystem to segments, used by the "Image" effect
+ *
+ * With PSRAM, frames are decoded once, scaled to segment size (nearest neighbour or bilinear), gamma corrected and
+ * cached together with their frame delay. Segments showing the same image at the same size share the cache, so any
+ * number of segments can play images and playback does not need to decode anything.
+ * There is a single decoder which is used by one segment at a time (one frame per call) while it fills a cache.
+ * If there is no PSRAM or the image does not fit IMAGE_CACHE_SIZE, frames are decoded on the fly (one segment only).
+ *
+ * Video clips (.wvc, see tools/video2wvc.py) are raw RGB frames at segment resolution (at most the segment's virtual
+ * size). The next frame is read in one block from the loop while the strip is idle (prefetchVideoFrames()), so
+ * the effect only copies it to the segment when it is due (and reads it itself only if the loop did not get to it).
  */
 
+#ifndef IMAGE_CACHE_SIZE
+#define IMAGE_CACHE_SIZE (1024*1024)  // PSRAM used for decoded frames (all images)
+#endif
+#define IMAGE_CACHE_MAX_FRAMES 1024
+#define IMAGE_IDLE_TIMEOUT     5000   // release playback of segments that stopped rendering an image (ms)
+
 File file;
-char lastFilename[34] = "/";
 GifDecoder<320,320,12,true> decoder;
-bool gifDecodeFailed = false;
-unsigned long lastFrameDisplayTime = 0, currentFrameDelay = 0;
+static bool decoderRewound = false;   // decoder seeked to start of file (last frame was decoded)
+static bool decoderStarted = false;
 
 bool fileSeekCallback(unsigned long position) {
+  if (decoderStarted && position == 0) decoderRewound = true;
   return file.seek(position);
 }
 
@@ -42,23 +58,77 @@ bool openGif(const char *filename) {
   return true;
 }
 
-Segment* activeSeg;
+// decoded frames of one image at one size
+typedef struct ImageCache {
+  char     name[33];
+  uint16_t width, height;             // segment size
+  bool     smooth;                    // bilinear scaling
+  bool     complete;                  // all frames decoded
+  bool     failed;                    // did not fit, frames freed
+  uint8_t  users;
+  std::vector<uint8_t*> frames;       // RGB, width*height*3 bytes each
+  std::vector<uint16_t> delays;       // frame delay in ms
+} image_cache_t;
+
+// .wvc video clip header, followed by frameCount frames of width*height RGB triplets (row by row)
+#define VIDEO_MAGIC   0x4C435657  // "WVCL"
+#define VIDEO_VERSION 1
+typedef struct VideoHeader {
+  uint32_t magic;
+  uint8_t  version;
+  uint8_t  reserved;
+  uint16_t width, height;
+  uint16_t frameDelay;  // ms, 0 = effect frame rate
+  uint32_t frameCount;
+} __attribute__((packed)) video_header_t;
+
+// playback state of a segment
+typedef struct ImagePlayer {
+  Segment    *seg;
+  ImageCache *cache;                  // nullptr if not cached
+  bool        streaming;              // decoding on the fly
+  byte        error;
+  uint16_t    frame;                  // next frame to show from cache
+  File        video;                  // .wvc clip (instead of GIF)
+  uint8_t    *videoBuffer;            // next frame, read ahead
+  bool        videoFrameReady;        // videoBuffer holds frame videoFrame
+  uint32_t    videoFrame;             // next frame to show
+  video_header_t videoHeader;
+  unsigned long lastFrameDisplayTime, currentFrameDelay, lastRender;
+  char        name[33];
+} image_player_t;
+
+static std::vector<ImageCache*> imageCaches;
+static std::vector<ImagePlayer> imagePlayers;
+static size_t imageCacheUsed = 0;
+
+static Segment *decoderSeg = nullptr;  // segment using the decoder
+static ImageCache *decoderCache = nullptr;
+static uint8_t *canvas = nullptr;      // RGB frame at GIF resolution (PSRAM only)
+static uint16_t decodedFrames = 0;
 uint16_t gifWidth, gifHeight;
 
 void screenClearCallback(void) {
-  activeSeg->fill(0);
+  if (canvas) memset(canvas, 0, gifWidth * gifHeight * 3);
+  else if (decoderSeg) decoderSeg->fill(0);
 }
 
 void updateScreenCallback(void) {}
 
 void drawPixelCallback(int16_t x, int16_t y, uint8_t red, uint8_t green, uint8_t blue) {
-  // simple nearest-neighbor scaling 
-  int16_t outY = y * activeSeg->height() / gifHeight;
-  int16_t outX = x * activeSeg->width()  / gifWidth;
+  if (canvas) {
+    if (x >= gifWidth || y >= gifHeight) return;
+    uint8_t *p = canvas + (y * gifWidth + x) * 3;
+    p[0] = red; p[1] = green; p[2] = blue;
+    return;
+  }
+  // no canvas: simple nearest-neighbor scaling directly into segment
+  int16_t outY = y * decoderSeg->height() / gifHeight;
+  int16_t outX = x * decoderSeg->width()  / gifWidth;
   // set multiple pixels if upscaling
-  for (int16_t i = 0; i < (activeSeg->width()+(gifWidth-1)) / gifWidth; i++) {
-    for (int16_t j = 0; j < (activeSeg->height()+(gifHeight-1)) / gifHeight; j++) {
-      activeSeg->setPixelColorXY(outX + i, outY + j, gamma8(red), gamma8(green), gamma8(blue));
+  for (int16_t i = 0; i < (decoderSeg->width()+(gifWidth-1)) / gifWidth; i++) {
+    for (int16_t j = 0; j < (decoderSeg->height()+(gifHeight-1)) / gifHeight; j++) {
+      decoderSeg->setPixelColorXY(outX + i, outY + j, gamma8(red), gamma8(green), gamma8(blue));
     }
   }
 }
@@ -71,74 +141,345 @@ void drawPixelCallback(int16_t x, int16_t y, uint8_t red, uint8_t green, uint8_t
 #define IMAGE_ERROR_DECODER_ALLOC 5
 #define IMAGE_ERROR_GIF_DECODE 6
 #define IMAGE_ERROR_FRAME_DECODE 7
+#define IMAGE_ERROR_VIDEO_FORMAT 8
 #define IMAGE_ERROR_WAITING 254
 #define IMAGE_ERROR_PREV 255
 
-// renders an image (.gif only; .bmp and .fseq to be added soon) from FS to a segment
+// scale canvas to w*h RGB (gamma corrected), 16.16 fixed point source coordinates
+static void scaleCanvas(uint8_t *dst, unsigned w, unsigned h, bool smooth) {
+  const uint32_t stepX = (uint32_t(gifWidth) << 16) / w;
+  const uint32_t stepY = (uint32_t(gifHeight) << 16) / h;
+  if (!smooth) {
+    for (unsigned y = 0, sy = stepY / 2; y < h; y++, sy += stepY) {
+      const uint8_t *row = canvas + (sy >> 16) * gifWidth * 3;
+      for (unsigned x = 0, sx = stepX / 2; x < w; x++, sx += stepX) {
+        const uint8_t *p = row + (sx >> 16) * 3;
+        *dst++ = gamma8(p[0]); *dst++ = gamma8(p[1]); *dst++ = gamma8(p[2]);
+      }
+    }
+    return;
+  }
+  // bilinear: sample at pixel centers
+  for (unsigned y = 0; y < h; y++) {
+    int32_t fy = int32_t(y * stepY + stepY / 2) - 0x8000;
+    if (fy < 0) fy = 0;
+    unsigned y0 = fy >> 16, y1 = min(y0 + 1, unsigned(gifHeight - 1)), wy = (fy >> 8) & 0xFF;
+    const uint8_t *r0 = canvas + y0 * gifWidth * 3, *r1 = canvas + y1 * gifWidth * 3;
+    for (unsigned x = 0; x < w; x++) {
+      int32_t fx = int32_t(x * stepX + stepX / 2) - 0x8000;
+      if (fx < 0) fx = 0;
+      unsigned x0 = fx >> 16, x1 = min(x0 + 1, unsigned(gifWidth - 1)), wx = (fx >> 8) & 0xFF;
+      for (unsigned c = 0; c < 3; c++) {
+        unsigned top = r0[x0*3+c] * (256 - wx) + r0[x1*3+c] * wx;
+        unsigned bot = r1[x0*3+c] * (256 - wx) + r1[x1*3+c] * wx;
+        *dst++ = gamma8((top * (256 - wy) + bot * wy) >> 16);
+      }
+    }
+  }
+}
+
+static void drawFrame(Segment &seg, const uint8_t *rgb, unsigned w, unsigned h) {
+  for (unsigned y = 0; y < h; y++)
+    for (unsigned x = 0; x < w; x++, rgb += 3) seg.setPixelColorXY(int(x), int(y), rgb[0], rgb[1], rgb[2]);
+}
+
+static void freeCacheFrames(ImageCache *cache) {
+  for (auto frame : cache->frames) p_free(frame);
+  imageCacheUsed -= cache->frames.size() * cache->width * cache->height * 3;
+  cache->frames.clear();
+  cache->delays.clear();
+}
+
+static void releaseCache(ImageCache *cache) {
+  if (!cache || --cache->users) return;
+  if (decoderCache == cache) decoderCache = nullptr;
+  freeCacheFrames(cache);
+  imageCaches.erase(std::find(imageCaches.begin(), imageCaches.end(), cache));
+  delete cache;
+}
+
+static ImageCache *getCache(const char *name, unsigned w, unsigned h, bool smooth) {
+  for (auto cache : imageCaches) {
+    if (!cache->failed && cache->width == w && cache->height == h && cache->smooth == smooth && strcmp(cache->name, name) == 0) {
+      cache->users++;
+      return cache;
+    }
+  }
+  ImageCache *cache = new(std::nothrow) ImageCache();
+  if (!cache) return nullptr;
+  strlcpy(cache->name, name, sizeof(cache->name));
+  cache->width = w; cache->height = h; cache->smooth = smooth; cache->users = 1;
+  imageCaches.push_back(cache);
+  return cache;
+}
+
+static void closeDecoder() {
+  if (file) file.close();
+  decoder.dealloc();
+  if (canvas) p_free(canvas);
+  canvas = nullptr;
+  decoderSeg = nullptr;
+  decoderCache = nullptr;
+  decoderStarted = false;
+}
+
+static void stopPlayer(ImagePlayer &p) {
+  if (decoderSeg == p.seg) closeDecoder();
+  releaseCache(p.cache);
+  p.cache = nullptr;
+  p.streaming = false;
+  p.error = IMAGE_ERROR_NONE;
+  p.frame = 0;
+  p.lastFrameDisplayTime = p.currentFrameDelay = 0;
+  if (p.video) p.video.close();
+  if (p.videoBuffer) p_free(p.videoBuffer);
+  p.videoBuffer = nullptr;
+  p.videoFrameReady = false;
+}
+
+static inline size_t videoFrameSize(const video_header_t &hdr) {
+  return size_t(hdr.width) * hdr.height * 3;
+}
+
+static bool readVideoFrame(ImagePlayer &p) {
+  const video_header_t &hdr = p.videoHeader;
+  size_t frameSize = videoFrameSize(hdr);
+  if (p.videoFrame >= hdr.frameCount) { // loop
+    p.videoFrame = 0;
+    if (!p.video.seek(sizeof(video_header_t))) return false;
+  }
+  return p.video.read(p.videoBuffer, frameSize) == frameSize;
+}
+
+static byte openVideo(ImagePlayer &p) {
+  char path[34] = "/";
+  strlcpy(path + 1, p.name, sizeof(path) - 1);
+  p.video = WLED_FS.open(path, "r");
+  if (!p.video) return IMAGE_ERROR_FILE_MISSING;
+  video_header_t &hdr = p.videoHeader;
+  if (p.video.read(reinterpret_cast<uint8_t*>(&hdr), sizeof(hdr)) != sizeof(hdr) || hdr.magic != VIDEO_MAGIC || hdr.version != VIDEO_VERSION
+      || !hdr.width || !hdr.height || !hdr.frameCount || hdr.width > p.seg->vWidth() || hdr.height > p.seg->vHeight() // clip must fit the segment
+      || p.video.size() < sizeof(hdr) + uint64_t(videoFrameSize(hdr)) * hdr.frameCount)
+    return IMAGE_ERROR_VIDEO_FORMAT;
+  p.videoBuffer = static_cast<uint8_t*>(p_malloc(videoFrameSize(hdr)));
+  if (!p.videoBuffer) return IMAGE_ERROR_DECODER_ALLOC;
+  p.videoFrame = 0;
+  DEBUG_PRINTF_P(PSTR("Video %s: %ux%u, %u frames.\n"), p.name, hdr.width, hdr.height, hdr.frameCount);
+  return IMAGE_ERROR_NONE;
+}
+
+// shows the next frame (clipped to segment, which may have been resized since the clip was opened)
+static byte renderVideoFrame(ImagePlayer &p, Segment &seg) {
+  const video_header_t &hdr = p.videoHeader;
+  if (!p.videoFrameReady && !readVideoFrame(p)) return p.error = IMAGE_ERROR_FRAME_DECODE; // not read ahead (first frame)
+  p.videoFrameReady = false;
+  unsigned w = min(unsigned(seg.vWidth()), unsigned(hdr.width)), h = min(unsigned(seg.vHeight()), unsigned(hdr.height));
+  for (unsigned y = 0; y < h; y++) {
+    const uint8_t *rgb = p.videoBuffer + size_t(y) * hdr.width * 3;
+    for (unsigned x = 0; x < w; x++, rgb += 3) seg.setPixelColorXY(int(x), int(y), gamma8(rgb[0]), gamma8(rgb[1]), gamma8(rgb[2]));
+  }
+  p.currentFrameDelay = hdr.frameDelay;
+  p.videoFrame++;
+  return IMAGE_ERROR_NONE;
+}
+
+// takes the decoder for the player's image, decoder state continues if it is already in use by this segment
+static byte openDecoder(ImagePlayer &p) {
+  if (decoderSeg == p.seg && decoderCache == p.cache) return IMAGE_ERROR_NONE;
+  if (decoderSeg && decoderSeg != p.seg) return p.streaming ? IMAGE_ERROR_SEG_LIMIT : IMAGE_ERROR_WAITING;
+  if (decoderSeg) closeDecoder();
+  char path[34] = "/";
+  strlcpy(path + 1, p.name, sizeof(path) - 1);
+  openGif(path);
+  if (!file) return p.error = IMAGE_ERROR_FILE_MISSING;
+  decoderSeg = p.seg;
+  decoderCache = p.cache;
+  decodedFrames = 0;
+  decoder.setScreenClearCallback(screenClearCallback);
+  decoder.setUpdateScreenCallback(updateScreenCallback);
+  decoder.setDrawPixelCallback(drawPixelCallback);
+  decoder.setFileSeekCallback(fileSeekCallback);
+  decoder.setFilePositionCallback(filePositionCallback);
+  decoder.setFileReadCallback(fileReadCallback);
+  decoder.setFileReadBlockCallback(fileReadBlockCallback);
+  decoder.setFileSizeCallback(fileSizeCallback);
+  decoder.alloc();
+  DEBUG_PRINTLN(F("Starting decoding"));
+  if (decoder.startDecoding() < 0) { closeDecoder(); return p.error = IMAGE_ERROR_GIF_DECODE; }
+  decoder.getSize(&gifWidth, &gifHeight);
+  if (psramSafe && psramFound() && gifWidth && gifHeight) {
+    canvas = static_cast<uint8_t*>(p_calloc(gifWidth * gifHeight, 3));
+  }
+  if (!canvas && p.cache) { closeDecoder(); return IMAGE_ERROR_DECODER_ALLOC; } // caller falls back to streaming
+  decoderStarted = true;
+  DEBUG_PRINTLN(F("Decoding started"));
+  return IMAGE_ERROR_NONE;
+}
+
+// adds decoded canvas to cache, returns false if it does not fit
+static bool appendFrame(ImageCache *cache, unsigned long delay) {
+  size_t frameSize = cache->width * cache->height * 3;
+  if (cache->frames.size() >= IMAGE_CACHE_MAX_FRAMES || imageCacheUsed + frameSize > IMAGE_CACHE_SIZE) return false;
+  uint8_t *frame = static_cast<uint8_t*>(p_malloc(frameSize));
+  if (!frame) return false;
+  scaleCanvas(frame, cache->width, cache->height, cache->smooth);
+  cache->frames.push_back(frame);
+  cache->delays.push_back(min(delay, 65535UL));
+  imageCacheUsed += frameSize;
+  return true;
+}
+
+// decodes next frame into cache (decoding frames already cached again after decoder was taken over) or segment
+static byte decodeFrame(ImagePlayer &p, Segment &seg) {
+  byte result = openDecoder(p);
+  if (result != IMAGE_ERROR_NONE) return result;
+  do {
+    decoderRewound = false;
+    if (decoder.decodeFrame(false) < 0) { closeDecoder(); return p.error = IMAGE_ERROR_FRAME_DECODE; }
+  } while (p.cache && ++decodedFrames <= p.cache->frames.size() && !decoderRewound);
+  unsigned long delay = decoder.getFrameDelay_ms();
+
+  if (p.cache) {
+    if (decodedFrames > p.cache->frames.size() && !appendFrame(p.cache, delay)) {
+      DEBUG_PRINTF_P(PSTR("Image %s does not fit cache.\n"), p.name);
+      p.cache->failed = true;  // other segments will wait for the decoder
+      freeCacheFrames(p.cache);
+      releaseCache(p.cache);
+      p.cache = nullptr;
+      decoderCache = nullptr;
+      p.streaming = true;
+    } else {
+      if (decoderRewound) { // last frame decoded, decoder is no longer needed
+        p.cache->complete = true;
+        DEBUG_PRINTF_P(PSTR("Image %s cached, %u frames.\n"), p.name, p.cache->frames.size());
+        closeDecoder();
+      }
+      return IMAGE_ERROR_NONE;
+    }
+  }
+  // not cached, draw decoded frame to segment
+  if (canvas) {
+    unsigned w = seg.width(), h = seg.height();
+    uint8_t *frame = static_cast<uint8_t*>(p_malloc(w * h * 3));
+    if (frame) {
+      scaleCanvas(frame, w, h, seg.check1);
+      drawFrame(seg, frame, w, h);
+      p_free(frame);
+    }
+  }
+  p.currentFrameDelay = delay;
+  return IMAGE_ERROR_NONE;
+}
+
+// shows next GIF frame from cache or decodes it
+static byte renderGifFrame(ImagePlayer &p, Segment &seg) {
+  unsigned w = seg.width(), h = seg.height();
+  if (p.cache && (p.cache->failed || p.cache->width != w || p.cache->height != h || p.cache->smooth != seg.check1)) {
+    if (decoderSeg == p.seg) closeDecoder();
+    if (p.cache->failed) p.streaming = true;
+    releaseCache(p.cache);
+    p.cache = nullptr;
+    p.frame = 0;
+  }
+  if (!p.cache && !p.streaming) {
+    if (psramSafe && psramFound()) p.cache = getCache(p.name, w, h, seg.check1);
+    p.streaming = !p.cache;
+  }
+
+  byte result = IMAGE_ERROR_NONE;
+  if (!p.cache) result = decodeFrame(p, seg);
+  else if (p.frame >= p.cache->frames.size()) {
+    if (p.cache->complete) p.frame = 0;
+    else result = decodeFrame(p, seg); // adds frame to cache (continues on the fly if it does not fit)
+  }
+  if (result == IMAGE_ERROR_DECODER_ALLOC) { // no canvas, decode on the fly
+    releaseCache(p.cache);
+    p.cache = nullptr;
+    p.streaming = true;
+    result = decodeFrame(p, seg);
+  }
+  if (result != IMAGE_ERROR_NONE) return result;
+  if (p.cache) {
+    if (p.frame >= p.cache->frames.size()) return IMAGE_ERROR_WAITING;
+    drawFrame(seg, p.cache->frames[p.frame], w, h);
+    p.currentFrameDelay = p.cache->delays[p.frame++];
+  }
+  return IMAGE_ERROR_NONE;
+}
+
+static void releaseIdlePlayers() {
+  for (auto it = imagePlayers.begin(); it != imagePlayers.end();) {
+    if (millis() - it->lastRender > IMAGE_IDLE_TIMEOUT) {
+      stopPlayer(*it);
+      it = imagePlayers.erase(it);
+    } else ++it;
+  }
+}
+
+static ImagePlayer *getPlayer(Segment &seg) {
+  for (auto &p : imagePlayers) if (p.seg == &seg) return &p;
+  ImagePlayer p = {};
+  p.seg = &seg;
+  imagePlayers.push_back(p);
+  return &imagePlayers.back();
+}
+
+// renders an image (.gif or .wvc video clip; .bmp and .fseq to be added soon) from FS to a segment
 byte renderImageToSegment(Segment &seg) {
   if (!seg.name) return IMAGE_ERROR_NO_NAME;
   // disable during effect transition, causes flickering, multiple allocations and depending on image, part of old FX remaining
   //if (seg.mode != seg.currentMode()) return IMAGE_ERROR_WAITING;
-  if (activeSeg && activeSeg != &seg) return IMAGE_ERROR_SEG_LIMIT; // only one segment at a time
-  activeSeg = &seg;
-
-  if (strncmp(lastFilename +1, seg.name, 32) != 0) { // segment name changed, load new image
-    strncpy(lastFilename +1, seg.name, 32);
-    gifDecodeFailed = false;
-    if (strcmp(lastFilename + strlen(lastFilename) - 4, ".gif") != 0) {
-      gifDecodeFailed = true;
-      return IMAGE_ERROR_UNSUPPORTED_FORMAT;
-    }
-    if (file) file.close();
-    openGif(lastFilename);
-    if (!file) { gifDecodeFailed = true; return IMAGE_ERROR_FILE_MISSING; }
-    decoder.setScreenClearCallback(screenClearCallback);
-    decoder.setUpdateScreenCallback(updateScreenCallback);
-    decoder.setDrawPixelCallback(drawPixelCallback);
-    decoder.setFileSeekCallback(fileSeekCallback);
-    decoder.setFilePositionCallback(filePositionCallback);
-    decoder.setFileReadCallback(fileReadCallback);
-    decoder.setFileReadBlockCallback(fileReadBlockCallback);
-    decoder.setFileSizeCallback(fileSizeCallback);
-    decoder.alloc();
-    DEBUG_PRINTLN(F("Starting decoding"));
-    if(decoder.startDecoding() < 0) { gifDecodeFailed = true; return IMAGE_ERROR_GIF_DECODE; }
-    DEBUG_PRINTLN(F("Decoding started"));
-  }
-
-  if (gifDecodeFailed) return IMAGE_ERROR_PREV;
-  if (!file) { gifDecodeFailed = true; return IMAGE_ERROR_FILE_MISSING; }
-  //if (!decoder) { gifDecodeFailed = true; return IMAGE_ERROR_DECODER_ALLOC; }
+  releaseIdlePlayers();
+  ImagePlayer &p = *getPlayer(seg);
+  p.lastRender = millis();
+
+  if (strncmp(p.name, seg.name, 32) != 0) { // segment name changed, load new image
+    stopPlayer(p);
+    strlcpy(p.name, seg.name, sizeof(p.name));
+    size_t len = strlen(p.name);
+    if (len >= 4 && strcmp(p.name + len - 4, ".wvc") == 0) p.error = openVideo(p);
+    else if (len < 4 || strcmp(p.name + len - 4, ".gif") != 0) p.error = IMAGE_ERROR_UNSUPPORTED_FORMAT;
+    if (p.error) return p.error;
+  }
+  if (p.error) return IMAGE_ERROR_PREV;
 
   // speed 0 = half speed, 128 = normal, 255 = full FX FPS
   // TODO: 0 = 4x slow, 64 = 2x slow, 128 = normal, 192 = 2x fast, 255 = 4x fast
-  uint32_t wait = currentFrameDelay * 2 - seg.speed * currentFrameDelay / 128;
+  uint32_t wait = p.currentFrameDelay * 2 - seg.speed * p.currentFrameDelay / 128;
 
   // TODO consider handling this on FX level with a different frametime, but that would cause slow gifs to speed up during transitions
-  if (millis() - lastFrameDisplayTime < wait) return IMAGE_ERROR_WAITING;
+  if (millis() - p.lastFrameDisplayTime < wait) return IMAGE_ERROR_WAITING;
 
-  decoder.getSize(&gifWidth, &gifHeight);
+  byte result = p.videoBuffer ? renderVideoFrame(p, seg) : renderGifFrame(p, seg);
+  if (result != IMAGE_ERROR_NONE) return result;
 
-  int result = decoder.decodeFrame(false);
-  if (result < 0) { gifDecodeFailed = true; return IMAGE_ERROR_FRAME_DECODE; }
-
-  currentFrameDelay = decoder.getFrameDelay_ms();
-  unsigned long tooSlowBy = (millis() - lastFrameDisplayTime) - wait; // if last frame was longer than intended, compensate
-  currentFrameDelay = tooSlowBy > currentFrameDelay ? 0 : currentFrameDelay - tooSlowBy;
-  lastFrameDisplayTime = millis();
+  unsigned long tooSlowBy = (millis() - p.lastFrameDisplayTime) - wait; // if last frame was longer than intended, compensate
+  p.currentFrameDelay = tooSlowBy > p.currentFrameDelay ? 0 : p.currentFrameDelay - tooSlowBy;
+  p.lastFrameDisplayTime = millis();
 
   return IMAGE_ERROR_NONE;
 }
 
+// reads the next frame of one video clip per call while the strip is idle, called from loop
+void prefetchVideoFrames() {
+  if (strip.isUpdating()) return; // accessing FS during sendout causes glitches
+  for (auto &p : imagePlayers) {
+    if (!p.videoBuffer || p.videoFrameReady || p.error) continue;
+    p.videoFrameReady = readVideoFrame(p);
+    if (!p.videoFrameReady) p.error = IMAGE_ERROR_FRAME_DECODE;
+    return;
+  }
+}
+
 void endImagePlayback(Segment *seg) {
   DEBUG_PRINTLN(F("Image playback end called"));
-  if (!activeSeg || activeSeg != seg) return;
-  if (file) file.close();
-  decoder.dealloc();
-  gifDecodeFailed = false;
-  activeSeg = nullptr;
-  lastFilename[1] = '\0';
-  DEBUG_PRINTLN(F("Image playback ended"));
+  for (auto it = imagePlayers.begin(); it != imagePlayers.end(); ++it) {
+    if (it->seg != seg) continue;
+    stopPlayer(*it);
+    imagePlayers.erase(it);
+    DEBUG_PRINTLN(F("Image playback ended"));
+    return;
+  }
 }
 
-#endif
\ No newline at end of file
+#endif
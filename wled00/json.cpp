@@ -629,6 +629,7 @@ static void serializeSegment(JsonObject& root, const Segment& seg, byte id, bool
   root["si"]  = seg.soundSim;
   root["m12"] = seg.map1D2D;
   root["bm"]  = seg.blendMode;
+  if (!forPreset && seg.getBudget()) root[F("budget")] = seg.getBudget(); // read-only: adaptive effect workload (particle systems)
 }
 
 void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segmentBounds, bool selectedSegmentsOnly)
@@ -832,9 +833,22 @@ void serializeInfo(JsonObject root)
   root[F("freeheap")] = ESP.getFreeHeap();
   #if defined(ARDUINO_ARCH_ESP32)
   if (psramFound()) root[F("psram")] = ESP.getFreePsram();
+  if (psramSafe && psramFound()) serializeFileCacheInfo(root);
   #endif
   root[F("uptime")] = millis()/1000 + rolloverMillis*4294967;
 
+  JsonObject boot = root.createNestedObject(F("boot")); // boot phase durations in ms
+  boot[F("fs")]    = bootPhaseTime[BOOT_PHASE_FS];
+  boot[F("cfg")]   = bootPhaseTime[BOOT_PHASE_CFG];
+  boot[F("pal")]   = bootPhaseTime[BOOT_PHASE_PALETTES];
+  boot[F("map")]   = bootPhaseTime[BOOT_PHASE_LEDMAP];
+  boot[F("strip")] = bootPhaseTime[BOOT_PHASE_STRIP];
+  boot[F("um")]    = bootPhaseTime[BOOT_PHASE_USERMODS];
+  boot[F("srv")]   = bootPhaseTime[BOOT_PHASE_SERVER];
+  boot[F("light")] = bootPhaseTime[BOOT_PHASE_LIGHT];
+  boot[F("total")] = bootPhaseTime[BOOT_PHASE_TOTAL];
+  boot[F("snap")]  = bootSnapshot;
+
   char time[32];
   getTimeString(time);
   root[F("time")] = time;
@@ -924,14 +938,16 @@ void setPaletteColors(JsonArray json, byte* tcp)
     }
 }
 
+#ifdef ESP8266
+#define PALETTES_PER_PAGE 5
+#else
+#define PALETTES_PER_PAGE 8
+#endif
+
 void serializePalettes(JsonObject root, int page)
 {
   byte tcp[72];
-  #ifdef ESP8266
-  int itemPerPage = 5;
-  #else
-  int itemPerPage = 8;
-  #endif
+  int itemPerPage = PALETTES_PER_PAGE;
 
   int customPalettesCount = customPalettes.size();
   int palettesCount = getPaletteCount() - customPalettesCount;
@@ -1041,13 +1057,13 @@ void serializeModeData(JsonArray fxdata)
 {
   char lineBuffer[256];
   for (size_t i = 0; i < strip.getModeCount(); i++) {
-    strncpy_P(lineBuffer, strip.getModeData(i), sizeof(lineBuffer)/sizeof(char)-1);
-    lineBuffer[sizeof(lineBuffer)/sizeof(char)-1] = '\0'; // terminate string
-    if (lineBuffer[0] != 0) {
-      char* dataPtr = strchr(lineBuffer,'@');
-      if (dataPtr) fxdata.add(dataPtr+1);
-      else         fxdata.add("");
-    }
+    const char *data = strip.getModeData(i);
+    unsigned nameLen = strip.getModeMeta(i).nameLen;
+    if (pgm_read_byte(data + nameLen) == '@') {
+      strncpy_P(lineBuffer, data + nameLen + 1, sizeof(lineBuffer)/sizeof(char)-1);
+      lineBuffer[sizeof(lineBuffer)/sizeof(char)-1] = '\0'; // terminate string
+      fxdata.add(lineBuffer);
+    } else if (nameLen > 0) fxdata.add("");
   }
 }
 
@@ -1057,13 +1073,9 @@ void serializeModeNames(JsonArray arr)
 {
   char lineBuffer[256];
   for (size_t i = 0; i < strip.getModeCount(); i++) {
-    strncpy_P(lineBuffer, strip.getModeData(i), sizeof(lineBuffer)/sizeof(char)-1);
-    lineBuffer[sizeof(lineBuffer)/sizeof(char)-1] = '\0'; // terminate string
-    if (lineBuffer[0] != 0) {
-      char* dataPtr = strchr(lineBuffer,'@');
-      if (dataPtr) *dataPtr = 0; // terminate mode data after name
-      arr.add(lineBuffer);
-    }
+    if (pgm_read_byte(strip.getModeData(i)) == '\0') continue;
+    extractModeName(i, nullptr, lineBuffer, sizeof(lineBuffer)/sizeof(char)-1); // name is located using the index built in addEffect()
+    arr.add(lineBuffer);
   }
 }
 
@@ -1091,6 +1103,71 @@ class LockedJsonResponse: public AsyncJsonResponse {
   virtual ~LockedJsonResponse() { if (_holding_lock) releaseJSONBufferLock(); };
 };
 
+#ifdef WLED_ENABLE_JSON_CACHE
+// pre-serialized responses for JSON endpoints whose content only changes when effects are added or custom palettes are (re)loaded
+// blobs are reference counted so a response still being sent keeps its data even if the cache is invalidated meanwhile
+// the cache is only accessed from the web server (async_tcp) task, invalidateJsonCache() may be called from anywhere
+typedef struct {
+  std::shared_ptr<char> data;
+  size_t                len;
+  uint16_t              eTag;
+} JsonCacheEntry;
+
+static std::vector<JsonCacheEntry> jsonCache;           // slot 0: /json/eff, slot 1: /json/fxdata, slot 2+: /json/palx pages
+static volatile uint8_t            jsonCacheGeneration = 0;
+static uint8_t                     jsonCacheValidFor   = 0;
+
+void invalidateJsonCache() {
+  jsonCacheGeneration++;
+}
+
+// returns false if the response could not be served from cache (JSON buffer busy or out of memory)
+static bool serveCachedJson(AsyncWebServerRequest* request, unsigned slot, int page = 0)
+{
+  if (jsonCacheValidFor != jsonCacheGeneration) {
+    jsonCacheValidFor = jsonCacheGeneration;
+    jsonCache.clear();
+  }
+  if (slot >= jsonCache.size()) jsonCache.resize(slot + 1, {nullptr, 0, 0});
+  JsonCacheEntry &entry = jsonCache[slot];
+
+  if (!entry.data) {
+    if (!requestJSONBufferLock(17)) return false;
+    pDoc->clear();
+    if      (slot == 0) serializeModeNames(pDoc->to<JsonArray>());
+    else if (slot == 1) serializeModeData(pDoc->to<JsonArray>());
+    else                serializePalettes(pDoc->to<JsonObject>(), page);
+    size_t len = measureJson(*pDoc);
+    char *buf = (char*)p_malloc(len + 1);
+    if (buf) {
+      serializeJson(*pDoc, buf, len + 1);
+      entry.data = std::shared_ptr<char>(buf, [](char *p) { p_free(p); });
+      entry.len  = len;
+      entry.eTag = crc16((const unsigned char*)buf, len); // content based, survives reboots and cache invalidations
+      DEBUG_PRINTF_P(PSTR("JSON cache: slot %u, %u bytes\n"), slot, len);
+    }
+    releaseJSONBufferLock();
+    if (!buf) return false;
+  }
+
+  if (handleIfNoneMatchCacheHeader(request, 200, entry.eTag)) return true;
+
+  std::shared_ptr<char> data = entry.data;
+  size_t len = entry.len;
+  AsyncWebServerResponse *response = request->beginResponse(FPSTR(CONTENT_TYPE_JSON), len,
+    [data, len](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+      size_t n = std::min(maxLen, len - index);
+      memcpy(buffer, data.get() + index, n);
+      return n;
+    });
+  setStaticContentCacheHeaders(response, 200, entry.eTag);
+  request->send(response);
+  return true;
+}
+#else
+void invalidateJsonCache() {}
+#endif
+
 void serveJson(AsyncWebServerRequest* request)
 {
   enum class json_target {
@@ -1115,7 +1192,10 @@ void serveJson(AsyncWebServerRequest* request)
   }
   #endif
   else if (url.indexOf("pal") > 0) {
-    request->send_P(200, FPSTR(CONTENT_TYPE_JSON), JSON_palette_names);
+    if (handleIfNoneMatchCacheHeader(request, 200)) return;
+    AsyncWebServerResponse *response = request->beginResponse_P(200, FPSTR(CONTENT_TYPE_JSON), JSON_palette_names);
+    setStaticContentCacheHeaders(response, 200);
+    request->send(response);
     return;
   }
   else if (url.length() > 6) { //not just /json
@@ -1123,6 +1203,20 @@ void serveJson(AsyncWebServerRequest* request)
     return;
   }
 
+  #ifdef WLED_ENABLE_JSON_CACHE
+  switch (subJson) {
+    case json_target::effects: if (serveCachedJson(request, 0)) return; break;
+    case json_target::fxdata:  if (serveCachedJson(request, 1)) return; break;
+    case json_target::palettes: {
+      int page = request->hasParam(F("page")) ? request->getParam(F("page"))->value().toInt() : 0;
+      page = constrain(page, 0, (getPaletteCount() - 1) / PALETTES_PER_PAGE);
+      if (serveCachedJson(request, 2 + page, page)) return;
+      break;
+    }
+    default: break;
+  }
+  #endif
+
   if (!requestJSONBufferLock(17)) {
     request->deferResponse();    
     return;
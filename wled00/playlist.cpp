@@ -18,6 +18,7 @@ static PlaylistEntry *playlistEntries = nullptr;
 static byte           playlistLen;               //number of playlist entries
 static int8_t         playlistIndex = -1;
 static uint16_t       playlistEntryDur = 0;      //duration of the current entry in tenths of seconds
+static bool           playlistShuffled = false;  //next iteration has already been shuffled (for prefetch)
 
 //values we need to keep about the parent playlist while inside sub-playlist
 static int16_t        parentPlaylistIndex = -1;
@@ -49,6 +50,7 @@ void unloadPlaylist() {
   }
   currentPlaylist = playlistIndex = -1;
   playlistLen = playlistEntryDur = playlistOptions = 0;
+  playlistShuffled = false;
   DEBUG_PRINTLN(F("Playlist unloaded."));
 }
 
@@ -142,6 +144,23 @@ int16_t loadPlaylist(JsonObject playlistObj, byte presetId) {
 }
 
 
+// announce the preset that will follow current entry so it can be read during its duration
+static void prefetchNextEntry() {
+  if (playlistIndex < playlistLen - 1) {
+    prefetchPreset(playlistEntries[playlistIndex + 1].preset);
+  } else if (playlistRepeat == 1) {
+    if (parentPlaylistPresetId > 0) prefetchPreset(parentPlaylistPresetId);
+    else if (playlistEndPreset)     prefetchPreset(playlistEndPreset);
+  } else {
+    if ((playlistOptions & PL_OPTION_SHUFFLE) && !playlistShuffled) {
+      shufflePlaylist(); // shuffle next iteration in advance so its first entry is known
+      playlistShuffled = true;
+    }
+    prefetchPreset(playlistEntries[0].preset);
+  }
+}
+
+
 void handlePlaylist() {
   static unsigned long presetCycledTime = 0;
   if (currentPlaylist < 0 || playlistEntries == nullptr) return;
@@ -164,13 +183,15 @@ void handlePlaylist() {
       }
       if (playlistRepeat > 1) playlistRepeat--; // decrease repeat count on each index reset if not an endless playlist
       // playlistRepeat == 0: endless loop
-      if (playlistOptions & PL_OPTION_SHUFFLE) shufflePlaylist(); // shuffle playlist and start over
+      if ((playlistOptions & PL_OPTION_SHUFFLE) && !playlistShuffled) shufflePlaylist(); // shuffle playlist and start over
+      playlistShuffled = false;
     }
 
     jsonTransitionOnce = true;
     strip.setTransition(playlistEntries[playlistIndex].tr * 100);
     playlistEntryDur = playlistEntries[playlistIndex].dur > 0 ? playlistEntries[playlistIndex].dur : UINT16_MAX;
     applyPresetFromPlaylist(playlistEntries[playlistIndex].preset);
+    prefetchNextEntry();
     doAdvancePlaylist = false;
   }
 }
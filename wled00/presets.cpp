@@ -26,6 +26,590 @@ bool presetNeedsSaving() {
   return presetToSave;
 }
 
+/*
+ * Preset index
+ * Holds file offset of each preset object ("id":{...}) in presets.json so applying a preset does not need to scan
+ * the file for its key. Objects never move when another preset is written (writeObjectToFile() only overwrites in
+ * place, pads with spaces or appends) so the index is updated incrementally on save/delete.
+ * It is persisted in presets.idx together with the size of presets.json it was built for and rebuilt with a
+ * single pass over presets.json if that does not match or if a key read at an indexed position is wrong.
+ *
+ * Preset journal
+ * Saving a preset does not modify presets.json, instead a record {"id":{...}} (or {"id":null} for deletion) is
+ * appended as a single line to presets.jnl and the index entry points into the journal (PRESET_IN_JOURNAL).
+ * Save time therefore does not depend on presets.json size and the same flash sectors are not rewritten over
+ * and over. Once the journal grows over PRESET_JOURNAL_LIMIT it is merged with presets.json into presets.tmp
+ * a few presets per loop while idle, which then replaces presets.json (rename is atomic on LittleFS).
+ * Records are only considered once their terminating newline is written, a torn record after a power loss is
+ * dropped on boot and the journal is compacted before another record is appended. If power is lost during
+ * compaction presets.tmp is discarded, if it is lost after rename the journal is simply replayed again.
+ * Journal records appended after the persisted index was saved are replayed on boot, so the index is not
+ * rewritten on every save.
+ * While records are pending presets.json is served merged with the journal (see servePresetsFile()).
+ * All accesses happen while holding the JSON buffer lock (except the streamed response, which uses a snapshot).
+ * The index is only (re)built from the loop, the web server task just checks the flags below.
+ */
+#define PRESET_INDEX_MAGIC 0x4A495057UL // "WPIJ"
+#define PRESET_INDEX_SIZE  251          // presets 1-250 (0 unused)
+#define PRESET_IN_JOURNAL  0x80000000UL // index entry is an offset in presets.jnl
+#ifndef PRESET_JOURNAL_LIMIT
+#define PRESET_JOURNAL_LIMIT 8192       // compact journal once it grows beyond this size
+#endif
+
+static const char presets_idx[] PROGMEM = "/presets.idx";
+static const char presets_jnl[] PROGMEM = "/presets.jnl";
+static const char presets_tmp[] PROGMEM = "/presets.tmp";
+static uint32_t *presetIndex = nullptr;           // offset of preset object in presets.json (or journal), 0 if preset does not exist
+static size_t presetIndexFileSize = 0;            // size of presets.json the index is valid for
+static size_t presetJournalSize = 0;              // size of presets.jnl the index is valid for
+static volatile bool presetIndexRebuild = false;  // presets.json was replaced, persisted index can't be trusted
+static volatile bool presetJournalDiscard = false;// presets.json was uploaded, journal belongs to old file
+static volatile bool presetIndexCheck = true;     // index has to be validated in loop (boot, presets.json changed)
+static bool presetJournalTorn = false;            // journal ends with an incomplete record, compact before appending
+
+static File compactFile;                          // presets.tmp while compaction is in progress
+static uint32_t *compactIndex = nullptr;          // index of presets.tmp
+static uint8_t compactNext = 0;                   // next preset to be copied into presets.tmp, 0 if not compacting
+static unsigned long lastJournalWrite = 0;
+static volatile uint8_t presetStreams = 0;        // number of responses streaming presets (compaction is postponed)
+
+static size_t getPresetsFileSize(const char *fileName = presets_json) {
+  if (doCloseFile) closeFile(); // flush pending writes
+  if (fileName != presets_json && !WLED_FS.exists(FPSTR(fileName))) return 0;
+  File file = WLED_FS.open(FPSTR(fileName), "r");
+  if (!file) return 0;
+  size_t size = file.size();
+  file.close();
+  return size;
+}
+
+/*
+ * Compiled presets
+ * On ESP32 with PSRAM presets are kept as MessagePack encoded objects (compact binary, no text parsing)
+ * so applying one needs neither reading presets.json nor JSON parsing. Presets are compiled when read or
+ * written and in the background (one per loop while idle) so the first button/playlist switch is fast too.
+ * The cache is dropped whenever the index is rebuilt, i.e. after presets.json was uploaded or changed using /edit
+ * (invalidatePresetIndex()) or found with a different size. Compaction keeps it as it writes the same presets.
+ */
+#ifdef ARDUINO_ARCH_ESP32
+#define PRESET_CACHE_BUDGET (256*1024)  // max. PSRAM used for compiled presets
+
+static uint8_t **compiledPresets = nullptr; // [PRESET_INDEX_SIZE], each: uint32_t length + MessagePack data
+static size_t compiledPresetsSize = 0;
+static uint8_t compileNext = 1;             // next preset to be compiled in background
+
+static inline bool usePresetCache() { return psramSafe && psramFound(); }
+
+static void dropCompiledPreset(byte index) {
+  if (!compiledPresets || index == 0 || index >= PRESET_INDEX_SIZE || !compiledPresets[index]) return;
+  compiledPresetsSize -= *(uint32_t*)compiledPresets[index];
+  p_free(compiledPresets[index]);
+  compiledPresets[index] = nullptr;
+}
+
+static void dropCompiledPresets() {
+  for (unsigned i = 1; i < PRESET_INDEX_SIZE; i++) dropCompiledPreset(i);
+  compileNext = 1;
+}
+
+static void compilePreset(byte index, const JsonDocument *doc) {
+  if (!usePresetCache() || index == 0 || index >= PRESET_INDEX_SIZE) return;
+  if (!compiledPresets) compiledPresets = static_cast<uint8_t**>(p_calloc(PRESET_INDEX_SIZE, sizeof(uint8_t*)));
+  if (!compiledPresets) return;
+  dropCompiledPreset(index);
+  if (doc->isNull()) return;
+  size_t len = measureMsgPack(*doc);
+  if (compiledPresetsSize + len > PRESET_CACHE_BUDGET) return;
+  uint8_t *blob = static_cast<uint8_t*>(p_malloc(len + sizeof(uint32_t)));
+  if (!blob) return;
+  *(uint32_t*)blob = len;
+  serializeMsgPack(*doc, blob + sizeof(uint32_t), len);
+  compiledPresets[index] = blob;
+  compiledPresetsSize += len;
+}
+
+static bool loadCompiledPreset(byte index, JsonDocument *dest) {
+  if (!compiledPresets || presetIndexRebuild || index == 0 || index >= PRESET_INDEX_SIZE || !compiledPresets[index]) return false;
+  const uint8_t *blob = compiledPresets[index];
+  return deserializeMsgPack(*dest, (const char*)(blob + sizeof(uint32_t)), *(const uint32_t*)blob) == DeserializationError::Ok; // const input: strings are copied
+}
+
+static inline bool isPresetCompiled(byte index) { return compiledPresets && index > 0 && index < PRESET_INDEX_SIZE && compiledPresets[index]; }
+#else
+static inline void dropCompiledPresets() {}
+static inline void compilePreset(byte, const JsonDocument *) {}
+static inline bool loadCompiledPreset(byte, JsonDocument *) { return false; }
+static inline bool isPresetCompiled(byte) { return false; }
+#endif
+
+/*
+ * Prefetched preset
+ * Playlists announce their next entry using prefetchPreset() so it is read (and encoded as MessagePack) while the
+ * current entry is still running and the switch does not wait for the filesystem. If the preset is not already
+ * compiled (see above) it is kept in a single buffer.
+ */
+static volatile byte presetToPrefetch = 0;
+static byte prefetchedPreset = 0;           // preset held in prefetchBuffer, 0 if none
+static uint8_t *prefetchBuffer = nullptr;
+static size_t prefetchLen = 0;
+
+void prefetchPreset(byte index) {
+  if (index > 0 && index < PRESET_INDEX_SIZE) presetToPrefetch = index;
+}
+
+static void dropPrefetchedPreset() {
+  p_free(prefetchBuffer);
+  prefetchBuffer = nullptr;
+  prefetchedPreset = 0;
+}
+
+static bool loadPrefetchedPreset(byte index, JsonDocument *dest) {
+  if (!prefetchBuffer || presetIndexRebuild || index != prefetchedPreset) return false;
+  return deserializeMsgPack(*dest, (const char*)prefetchBuffer, prefetchLen) == DeserializationError::Ok; // const input: strings are copied
+}
+
+// presets.json was uploaded or changed using /edit (called from web server task)
+void invalidatePresetIndex() {
+  presetJournalDiscard = true;
+  presetIndexRebuild = true; // compiled and prefetched presets are not used until the index is rebuilt
+  presetIndexCheck = true;
+  if (requestJSONBufferLock(24)) { // free them only while the loop can't use them, otherwise validatePresetIndex() does
+    dropCompiledPresets();
+    dropPrefetchedPreset();
+    releaseJSONBufferLock();
+  }
+}
+
+// single pass over presets.json recording position of each root level object with a numeric key
+static bool buildPresetIndex() {
+  File file = WLED_FS.open(FPSTR(presets_json), "r");
+  if (!file) return false;
+  DEBUG_PRINTLN(F("Building preset index."));
+  memset(presetIndex, 0, PRESET_INDEX_SIZE * sizeof(uint32_t));
+  uint8_t buf[256];
+  size_t pos = 0, len;
+  unsigned depth = 0, id = 0;
+  bool inString = false, escape = false, isKey = false, afterKey = false;
+  while ((len = file.read(buf, sizeof(buf))) > 0) {
+    for (size_t i = 0; i < len; i++, pos++) {
+      char c = buf[i];
+      if (inString) {
+        if      (escape)    escape = false;
+        else if (c == '\\') escape = true;
+        else if (c == '"') { inString = false; afterKey = isKey; }
+        else if (isKey) {
+          if (c >= '0' && c <= '9' && id < PRESET_INDEX_SIZE) id = id * 10 + (c - '0');
+          else isKey = false;
+        }
+        continue;
+      }
+      switch (c) {
+        case '"':  inString = true; isKey = (depth == 1); id = 0; afterKey = false; break;
+        case ':':  case ' ': case '\t': case '\r': case '\n': break;
+        case '{':
+          if (afterKey && id > 0 && id < PRESET_INDEX_SIZE && presetIndex[id] == 0) presetIndex[id] = pos; // first occurrence, like bufferedFind()
+          depth++;
+          afterKey = false;
+          break;
+        case '}':  if (depth) depth--; afterKey = false; break;
+        default:   afterKey = false; break;
+      }
+    }
+  }
+  file.close();
+  return true;
+}
+
+// applies journal records appended after presetJournalSize to the index, returns false if the last one is incomplete
+static bool replayPresetJournal(size_t jnlSize) {
+  if (presetJournalSize >= jnlSize) return presetJournalSize == jnlSize;
+  File file = WLED_FS.open(FPSTR(presets_jnl), "r");
+  if (!file || !file.seek(presetJournalSize)) return false;
+  DEBUG_PRINTF_P(PSTR("Replaying preset journal from %u.\n"), (unsigned)presetJournalSize);
+  uint8_t buf[256];
+  size_t pos = presetJournalSize, len, valuePos = 0;
+  unsigned state = 0, id = 0; // 0: '{', 1: '"', 2: id, 3: ':', 4: value, 5: rest of line
+  bool isNull = false;
+  while ((len = file.read(buf, sizeof(buf))) > 0) {
+    for (size_t i = 0; i < len; i++, pos++) {
+      char c = buf[i];
+      if (c == '\n') {
+        if (state == 5 && id > 0 && id < PRESET_INDEX_SIZE) presetIndex[id] = isNull ? 0 : PRESET_IN_JOURNAL | valuePos;
+        presetJournalSize = pos + 1;
+        state = 0; id = 0;
+        continue;
+      }
+      switch (state) {
+        case 0: state = c == '{' ? 1 : 6; break;
+        case 1: state = c == '"' ? 2 : 6; break;
+        case 2:
+          if (c >= '0' && c <= '9' && id < PRESET_INDEX_SIZE) id = id * 10 + (c - '0');
+          else state = c == '"' ? 3 : 6;
+          break;
+        case 3: state = c == ':' ? 4 : 6; break;
+        case 4: valuePos = pos; isNull = (c == 'n'); state = 5; break;
+        default: break; // 5: skip to end of record, 6: malformed record
+      }
+    }
+  }
+  file.close();
+  return presetJournalSize == jnlSize;
+}
+
+// loads persisted index if it was saved for current presets.json and (older or current) journal
+static bool loadPresetIndex(size_t fileSize, size_t jnlSize) {
+  File file = WLED_FS.open(FPSTR(presets_idx), "r");
+  if (!file) return false;
+  uint32_t hdr[3] = {0, 0, 0};
+  bool ok = file.size() == sizeof(hdr) + PRESET_INDEX_SIZE * sizeof(uint32_t)
+         && file.read((uint8_t*)hdr, sizeof(hdr)) == sizeof(hdr)
+         && hdr[0] == PRESET_INDEX_MAGIC && hdr[1] == fileSize && hdr[2] <= jnlSize
+         && file.read((uint8_t*)presetIndex, PRESET_INDEX_SIZE * sizeof(uint32_t)) == PRESET_INDEX_SIZE * sizeof(uint32_t);
+  file.close();
+  if (ok) presetJournalSize = hdr[2];
+  return ok;
+}
+
+static void savePresetIndex() {
+  File file = WLED_FS.open(FPSTR(presets_idx), "w");
+  if (!file) return;
+  uint32_t hdr[3] = {PRESET_INDEX_MAGIC, presetIndexFileSize, presetJournalSize};
+  file.write((const uint8_t*)hdr, sizeof(hdr));
+  file.write((const uint8_t*)presetIndex, PRESET_INDEX_SIZE * sizeof(uint32_t));
+  file.close();
+}
+
+static void abortCompaction() {
+  if (compactNext) compactFile.close();
+  compactNext = 0;
+  p_free(compactIndex);
+  compactIndex = nullptr;
+  if (WLED_FS.exists(FPSTR(presets_tmp))) WLED_FS.remove(FPSTR(presets_tmp));
+}
+
+// copies JSON object starting at pos, returns false if it is incomplete or could not be written
+static bool copyPresetObject(File &src, size_t pos, File &dst) {
+  if (!src || !src.seek(pos)) return false;
+  uint8_t buf[128];
+  size_t len;
+  unsigned depth = 0;
+  bool inString = false, escape = false;
+  while ((len = src.read(buf, sizeof(buf))) > 0) {
+    for (size_t i = 0; i < len; i++) {
+      char c = buf[i];
+      if (inString) {
+        if      (escape)    escape = false;
+        else if (c == '\\') escape = true;
+        else if (c == '"')  inString = false;
+      }
+      else if (c == '"') inString = true;
+      else if (c == '{') depth++;
+      else if (c == '}' && depth && --depth == 0) return dst.write(buf, i+1) == i+1;
+    }
+    if (dst.write(buf, len) != len) return false;
+  }
+  return false;
+}
+
+// merges up to count presets from presets.json and journal into presets.tmp, returns true once compaction ended
+static bool compactPresetStep(unsigned count) {
+  if (compactNext == 0) {
+    DEBUG_PRINTLN(F("Compacting presets."));
+    abortCompaction(); // remove leftovers
+    compactIndex = static_cast<uint32_t*>(p_calloc(PRESET_INDEX_SIZE, sizeof(uint32_t)));
+    if (compactIndex) compactFile = WLED_FS.open(FPSTR(presets_tmp), "w");
+    if (!compactIndex || !compactFile || compactFile.print(F("{\"0\":{}")) != 7) { abortCompaction(); return true; }
+    compactNext = 1;
+  }
+  File json = WLED_FS.open(FPSTR(presets_json), "r");
+  File jnl; if (presetJournalSize) jnl = WLED_FS.open(FPSTR(presets_jnl), "r");
+  bool ok = true;
+  for (; ok && compactNext < PRESET_INDEX_SIZE && count; compactNext++) {
+    uint32_t at = presetIndex[compactNext];
+    if (at == 0) continue;
+    char key[8];
+    size_t len = sprintf_P(key, PSTR(",\"%d\":"), compactNext);
+    ok = compactFile.write((const uint8_t*)key, len) == len;
+    compactIndex[compactNext] = compactFile.position();
+    ok = ok && copyPresetObject((at & PRESET_IN_JOURNAL) ? jnl : json, at & ~PRESET_IN_JOURNAL, compactFile);
+    count--;
+  }
+  json.close();
+  jnl.close();
+  if (ok && compactNext < PRESET_INDEX_SIZE) return false;
+  ok = ok && compactFile.print('}') == 1;
+  size_t fileSize = compactFile.position();
+  compactFile.close();
+  compactNext = 0;
+  if (!ok || !WLED_FS.rename(FPSTR(presets_tmp), FPSTR(presets_json))) {
+    DEBUG_PRINTLN(F("Compacting presets failed."));
+    abortCompaction();
+    return true;
+  }
+  WLED_FS.remove(FPSTR(presets_jnl));
+  invalidateFileCache(presets_json);
+  memcpy(presetIndex, compactIndex, PRESET_INDEX_SIZE * sizeof(uint32_t));
+  p_free(compactIndex);
+  compactIndex = nullptr;
+  presetIndexFileSize = fileSize;
+  presetJournalSize = 0; // compiled presets stay valid, presets.json holds the same presets
+  savePresetIndex();
+  return true;
+}
+
+// makes sure the index matches presets.json, loads or (re)builds it if necessary
+static bool validatePresetIndex() {
+  if (!presetIndex) presetIndex = static_cast<uint32_t*>(p_calloc(PRESET_INDEX_SIZE, sizeof(uint32_t)));
+  if (!presetIndex) return false;
+  size_t fileSize = getPresetsFileSize();
+  if (fileSize == 0) return false;
+  if (!presetIndexRebuild && fileSize == presetIndexFileSize) return true;
+  if (presetJournalDiscard && presetStreams) return false; // responses still read the old journal, use presets.json as is until they finished
+  abortCompaction();
+  dropCompiledPresets(); // presets.json may have changed
+  dropPrefetchedPreset();
+  if (presetJournalDiscard) {
+    if (WLED_FS.exists(FPSTR(presets_jnl))) WLED_FS.remove(FPSTR(presets_jnl));
+    presetJournalDiscard = false;
+  }
+  size_t jnlSize = getPresetsFileSize(presets_jnl);
+  bool loaded = !presetIndexRebuild && loadPresetIndex(fileSize, jnlSize);
+  presetIndexRebuild = false;
+  presetIndexFileSize = fileSize;
+  if (!loaded) {
+    presetJournalSize = 0;
+    if (!buildPresetIndex()) { presetIndexFileSize = 0; return false; }
+  }
+  size_t replayed = presetJournalSize;
+  if (!replayPresetJournal(jnlSize)) {
+    DEBUG_PRINTLN(F("Preset journal incomplete."));
+    presetJournalTorn = true; // index is valid up to the last complete record
+  }
+  if (!loaded || replayed != presetJournalSize) savePresetIndex();
+  return true;
+}
+
+// compacts a journal ending with a torn record (once), new records must not be appended to it
+static bool repairPresetJournal() {
+  if (!presetJournalTorn) return true;
+  if (presetStreams) return false; // responses still read presets.json and journal
+  presetJournalTorn = false;
+  while (!compactPresetStep(PRESET_INDEX_SIZE));
+  return presetJournalSize == 0;
+}
+
+// reads preset object from presets.json using index (falls back to key search)
+static bool readPresetFromFile(byte index, JsonDocument *dest) {
+  if (index > 0 && index < PRESET_INDEX_SIZE && validatePresetIndex()) {
+    if (presetIndex[index] == 0) {
+      dest->clear();
+      return false;
+    }
+    char objKey[10];
+    sprintf_P(objKey, PSTR("\"%d\":"), index);
+    uint32_t at = presetIndex[index];
+    if (readObjectFromFileAt((at & PRESET_IN_JOURNAL) ? presets_jnl : presets_json, objKey, at & ~PRESET_IN_JOURNAL, dest)) return true;
+    presetIndexRebuild = true; // index does not match file content
+    if (validatePresetIndex()) {
+      at = presetIndex[index];
+      if (at == 0) { dest->clear(); return false; }
+      if (readObjectFromFileAt((at & PRESET_IN_JOURNAL) ? presets_jnl : presets_json, objKey, at & ~PRESET_IN_JOURNAL, dest)) return true;
+    }
+  }
+  return readObjectFromFileUsingId(presets_json, index, dest);
+}
+
+// writes (or deletes if content is empty) preset object and updates index
+static bool writePresetToFile(byte index, const JsonDocument *content) {
+  if (index == 0 || index >= PRESET_INDEX_SIZE || !validatePresetIndex()) {
+    presetIndexFileSize = 0; // rebuild on next access
+    dropCompiledPresets();
+    dropPrefetchedPreset();
+    return writeObjectToFileUsingId(presets_json, index, content);
+  }
+  if (!repairPresetJournal()) return false;
+  abortCompaction(); // presets.tmp would miss this record
+  if (index == prefetchedPreset) dropPrefetchedPreset();
+  bool isNull = content->isNull();
+  char key[8];
+  size_t keyLen = sprintf_P(key, PSTR("{\"%d\":"), index);
+  size_t len = keyLen + (isNull ? 4 : measureJson(*content)) + 2;
+  File file = WLED_FS.open(FPSTR(presets_jnl), "a");
+  if (!file) return false;
+  size_t written = file.write((const uint8_t*)key, keyLen);
+  if (isNull) written += file.print(F("null"));
+  else        written += serializeJson(*content, file);
+  written += file.print(F("}\n"));
+  file.close();
+  lastJournalWrite = millis();
+  if (written != len) {
+    presetJournalTorn = true; // compacted before the next record is appended
+    return false;
+  }
+  presetIndex[index] = isNull ? 0 : PRESET_IN_JOURNAL | (presetJournalSize + keyLen);
+  presetJournalSize += len;
+  compilePreset(index, content); // content is empty when deleting
+  return true;
+}
+
+// validates index and merges journal into presets.json in small steps while idle
+static void compactPresetJournal() {
+  static unsigned long lastStep = 0;
+  if (jsonBufferLock || presetStreams || strip.isUpdating() || millis() - lastStep < 20) return;
+  bool compact = compactNext || (presetJournalSize >= PRESET_JOURNAL_LIMIT && millis() - lastJournalWrite >= 5000);
+  if (!compact && !presetIndexCheck && !presetJournalTorn) return;
+  if (!requestJSONBufferLock(9)) return;
+  lastStep = millis();
+  presetIndexCheck = false;
+  if (validatePresetIndex() && repairPresetJournal() && compact && presetJournalSize) compactPresetStep(8);
+  releaseJSONBufferLock();
+}
+
+/*
+ * Serving presets.json
+ * With journal records pending presets.json is incomplete. Instead of compacting it on the web server task the
+ * response is generated from a snapshot of the index: presets are sent in the order compaction would write them,
+ * each copied from presets.json or the journal. Offsets stay valid as the journal is only appended to and
+ * compaction and journal removal are postponed until all such responses have finished.
+ */
+struct PresetStream {
+  uint32_t index[PRESET_INDEX_SIZE];
+  File     json, jnl;
+  unsigned id = 1;           // preset being sent
+  char     pending[10];      // key (or closing brace) still to be sent
+  uint8_t  pendingLen = 0, pendingPos = 0;
+  unsigned depth = 0;        // object nesting while copying
+  bool     inObject = false, inString = false, escape = false, closed = false;
+  PresetStream()  { presetStreams++; }
+  ~PresetStream() { json.close(); jnl.close(); presetStreams--; }
+};
+
+// fills buffer with the next part of the merged presets.json, returns 0 once complete
+static size_t readPresetStream(PresetStream &s, uint8_t *buffer, size_t maxLen) {
+  size_t n = 0;
+  while (n < maxLen) {
+    if (s.pendingPos < s.pendingLen) {
+      buffer[n++] = s.pending[s.pendingPos++];
+      continue;
+    }
+    if (s.inObject) {
+      File &file = (s.index[s.id] & PRESET_IN_JOURNAL) ? s.jnl : s.json;
+      size_t len = file.read(buffer + n, maxLen - n);
+      if (len == 0) { s.id = PRESET_INDEX_SIZE; s.inObject = false; continue; } // truncated file, end response
+      for (size_t i = 0; i < len; i++) {
+        char c = buffer[n + i];
+        if (s.inString) {
+          if      (s.escape)    s.escape = false;
+          else if (c == '\\') s.escape = true;
+          else if (c == '"')    s.inString = false;
+        }
+        else if (c == '"') s.inString = true;
+        else if (c == '{') s.depth++;
+        else if (c == '}' && s.depth && --s.depth == 0) { len = i + 1; s.inObject = false; s.id++; break; }
+      }
+      n += len;
+      continue;
+    }
+    if (s.id >= PRESET_INDEX_SIZE) {
+      if (s.closed) break;
+      s.pending[0] = '}';
+      s.pendingLen = 1; s.pendingPos = 0;
+      s.closed = true;
+      continue;
+    }
+    uint32_t at = s.index[s.id];
+    if (at == 0) { s.id++; continue; }
+    File &file = (at & PRESET_IN_JOURNAL) ? s.jnl : s.json;
+    if (!file || !file.seek(at & ~PRESET_IN_JOURNAL)) { s.id++; continue; }
+    s.pendingLen = sprintf_P(s.pending, PSTR(",\"%d\":"), s.id);
+    s.pendingPos = 0;
+    s.depth = 0;
+    s.inString = s.escape = false;
+    s.inObject = true;
+  }
+  return n;
+}
+
+// sends presets.json merged with pending journal records, returns false if presets.json can be sent as is
+bool servePresetsFile(AsyncWebServerRequest *request) {
+  if (presetJournalDiscard) return false; // uploaded presets.json replaces the journal
+  bool validated = !presetIndexCheck && !presetIndexRebuild;
+  if (validated && presetJournalSize == 0) return false; // no records pending
+  if (!validated && !WLED_FS.exists(FPSTR(presets_jnl))) return false;
+  if (!validated) presetIndexCheck = true; // index is built in loop, not on the web server task
+  if (!validated || !requestJSONBufferLock(23)) {
+    request->send(503, FPSTR(CONTENT_TYPE_PLAIN), F("Busy, try again.")); // never send presets.json missing journalled presets
+    return true;
+  }
+  if (presetJournalDiscard || presetJournalSize == 0) { // changed while waiting for the lock
+    releaseJSONBufferLock();
+    return false;
+  }
+  std::shared_ptr<PresetStream> stream = std::make_shared<PresetStream>();
+  memcpy(stream->index, presetIndex, sizeof(stream->index));
+  stream->json = WLED_FS.open(FPSTR(presets_json), "r");
+  stream->jnl  = WLED_FS.open(FPSTR(presets_jnl), "r");
+  releaseJSONBufferLock();
+  memcpy(stream->pending, "{\"0\":{}", 7);
+  stream->pendingLen = 7;
+
+  AsyncWebServerResponse *response = request->beginChunkedResponse(FPSTR(CONTENT_TYPE_JSON),
+    [stream](uint8_t *buffer, size_t maxLen, size_t) -> size_t { return readPresetStream(*stream, buffer, maxLen); });
+  if (request->hasArg(F("download"))) response->addHeader(F("Content-Disposition"), F("attachment; filename=\"presets.json\""));
+  response->addHeader(F("Cache-Control"), F("no-store"));
+  request->send(response);
+  return true;
+}
+
+// reads preset from compiled cache, prefetch buffer or presets.json (compiling it)
+static bool readPreset(byte index, JsonDocument *dest) {
+  if (loadCompiledPreset(index, dest) || loadPrefetchedPreset(index, dest)) return true;
+  #if defined(ARDUINO_ARCH_ESP32S2) || defined(ARDUINO_ARCH_ESP32C3)
+  unsigned long maxWait = millis() + strip.getFrameTime();
+  while (strip.isUpdating() && millis() < maxWait) delay(1); // wait for strip to finish updating, accessing FS during sendout causes glitches
+  #endif
+  if (!readPresetFromFile(index, dest)) return false;
+  compilePreset(index, dest);
+  return true;
+}
+
+// reads preset announced by playlist while nothing else is going on
+static void handlePrefetch() {
+  if (presetToPrefetch == 0 || jsonBufferLock || strip.isUpdating()) return;
+  if (!requestJSONBufferLock(9)) return;
+  byte index = presetToPrefetch;
+  presetToPrefetch = 0;
+  if (index != prefetchedPreset && !isPresetCompiled(index) && readPreset(index, pDoc) && !isPresetCompiled(index)) {
+    dropPrefetchedPreset();
+    size_t len = measureMsgPack(*pDoc);
+    prefetchBuffer = static_cast<uint8_t*>(p_malloc(len));
+    if (prefetchBuffer) {
+      prefetchLen = serializeMsgPack(*pDoc, prefetchBuffer, len);
+      prefetchedPreset = index;
+      DEBUG_PRINTF_P(PSTR("Prefetched preset %u (%u bytes).\n"), (unsigned)index, (unsigned)len);
+    }
+  }
+  releaseJSONBufferLock();
+}
+
+#ifdef ARDUINO_ARCH_ESP32
+// compile one preset per call while nothing else is going on
+static void precompilePresets() {
+  static unsigned long lastCompile = 0;
+  if (!usePresetCache() || compileNext >= PRESET_INDEX_SIZE || jsonBufferLock || strip.isUpdating() || millis() - lastCompile < 20) return;
+  if (!requestJSONBufferLock(9)) return;
+  lastCompile = millis();
+  if (validatePresetIndex()) {
+    while (compileNext < PRESET_INDEX_SIZE && (presetIndex[compileNext] == 0 || (compiledPresets && compiledPresets[compileNext]))) compileNext++;
+    if (compileNext < PRESET_INDEX_SIZE) {
+      if (readPresetFromFile(compileNext, pDoc)) compilePreset(compileNext, pDoc);
+      compileNext++;
+    }
+  }
+  releaseJSONBufferLock();
+}
+#endif
+
 static void doSaveState() {
   bool persist = (presetToSave < 251);
 
@@ -68,7 +652,8 @@ static void doSaveState() {
     }
   } else
   #endif
-  writeObjectToFileUsingId(getPresetsFileName(persist), presetToSave, pDoc);
+  if (persist) writePresetToFile(presetToSave, pDoc);
+  else         writeObjectToFileUsingId(getPresetsFileName(persist), presetToSave, pDoc);
 
   if (persist) presetsModifiedTime = toki.second(); //unix time
   releaseJSONBufferLock();
@@ -88,7 +673,7 @@ bool getPresetName(byte index, String& name)
 {
   if (!requestJSONBufferLock(19)) return false;
   bool presetExists = false;
-  if (readObjectFromFileUsingId(getPresetsFileName(), index, pDoc)) {
+  if (readPreset(index, pDoc)) {
     JsonObject fdo = pDoc->as<JsonObject>();
     if (fdo["n"]) {
       name = (const char*)(fdo["n"]);
@@ -146,12 +731,20 @@ void handlePresets()
 {
   byte presetErrFlag = ERR_NONE;
   if (presetToSave) {
+    if (presetToSave < 251 && presetJournalTorn && presetStreams) return; // journal has to be compacted first, wait for presets.json responses
     strip.suspend();
     doSaveState();
     strip.resume();
     return;
   }
 
+  if (presetToApply == 0) {
+    handlePrefetch();
+    compactPresetJournal();
+    #ifdef ARDUINO_ARCH_ESP32
+    precompilePresets();
+    #endif
+  }
   if (presetToApply == 0 || !requestJSONBufferLock(9)) return; // no preset waiting to apply, or JSON buffer is already allocated, return to loop until free
 
   bool changePreset = false;
@@ -165,18 +758,19 @@ void handlePresets()
 
   DEBUG_PRINTF_P(PSTR("Applying preset: %u\n"), (unsigned)tmpPreset);
 
-  #if defined(ARDUINO_ARCH_ESP32S2) || defined(ARDUINO_ARCH_ESP32C3)
-  unsigned long maxWait = millis() + strip.getFrameTime();
-  while (strip.isUpdating() && millis() < maxWait) delay(1); // wait for strip to finish updating, accessing FS during sendout causes glitches
-  #endif
-
   #ifdef ARDUINO_ARCH_ESP32
   if (tmpPreset==255 && tmpRAMbuffer!=nullptr) {
     deserializeJson(*pDoc,tmpRAMbuffer);
   } else
   #endif
-  {
-  presetErrFlag = readObjectFromFileUsingId(getPresetsFileName(tmpPreset < 255), tmpPreset, pDoc) ? ERR_NONE : ERR_FS_PLOAD;
+  if (tmpPreset < 255) {
+    presetErrFlag = readPreset(tmpPreset, pDoc) ? ERR_NONE : ERR_FS_PLOAD; // waits for strip on S2/C3 if FS access is needed
+  } else {
+    #if defined(ARDUINO_ARCH_ESP32S2) || defined(ARDUINO_ARCH_ESP32C3)
+    unsigned long maxWait = millis() + strip.getFrameTime();
+    while (strip.isUpdating() && millis() < maxWait) delay(1); // wait for strip to finish updating, accessing FS during sendout causes glitches
+    #endif
+    presetErrFlag = readObjectFromFileUsingId(getPresetsFileName(false), tmpPreset, pDoc) ? ERR_NONE : ERR_FS_PLOAD;
   }
   fdo = pDoc->as<JsonObject>();
 
@@ -260,7 +854,7 @@ void savePreset(byte index, const char* pname, JsonObject sObj)
         sObj.remove(F("psave"));
         if (sObj["n"].isNull()) sObj["n"] = saveName;
         initPresetsFile(); // just in case if someone deleted presets.json using /edit
-        writeObjectToFileUsingId(getPresetsFileName(), index, pDoc);
+        writePresetToFile(index, pDoc);
         presetsModifiedTime = toki.second(); //unix time
         updateFSInfo();
       }
@@ -279,7 +873,7 @@ void savePreset(byte index, const char* pname, JsonObject sObj)
 
 void deletePreset(byte index) {
   StaticJsonDocument<24> empty;
-  writeObjectToFileUsingId(getPresetsFileName(), index, &empty);
+  writePresetToFile(index, &empty);
   presetsModifiedTime = toki.second(); //unix time
   updateFSInfo();
 }
\ No newline at end of file
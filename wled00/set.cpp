@@ -1,4 +1,5 @@
 #include "wled.h"
+#include "api_request.h"
 
 /*
  * Receives client input
@@ -833,22 +834,20 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply)
 {
   if (!(req.indexOf("win") >= 0)) return false;
 
-  int pos = 0;
   DEBUG_PRINTF_P(PSTR("API req: %s\n"), req.c_str());
+  const ApiRequest api(req.c_str());
 
   //segment select (sets main segment)
-  pos = req.indexOf(F("SM="));
-  if (pos > 0 && !realtimeMode) {
-    strip.setMainSegmentId(getNumVal(req, pos));
+  if (api.has(API_SM) && !realtimeMode) {
+    strip.setMainSegmentId(api.num(API_SM));
   }
 
   byte selectedSeg = strip.getFirstSelectedSegId();
 
   bool singleSegment = false;
 
-  pos = req.indexOf(F("SS="));
-  if (pos > 0) {
-    unsigned t = getNumVal(req, pos);
+  if (api.has(API_SS)) {
+    unsigned t = api.num(API_SS);
     if (t < strip.getSegmentsNum()) {
       selectedSeg = t;
       singleSegment = true;
@@ -856,9 +855,8 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply)
   }
 
   Segment& selseg = strip.getSegment(selectedSeg);
-  pos = req.indexOf(F("SV=")); //segment selected
-  if (pos > 0) {
-    unsigned t = getNumVal(req, pos);
+  if (api.has(API_SV)) { //segment selected
+    unsigned t = api.num(API_SV);
     if (t == 2) for (unsigned i = 0; i < strip.getSegmentsNum(); i++) strip.getSegment(i).selected = false; // unselect other segments
     selseg.selected = t;
   }
@@ -885,96 +883,71 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply)
   uint16_t stopY   = selseg.stopY;
   uint8_t  grpI    = selseg.grouping;
   uint16_t spcI    = selseg.spacing;
-  pos = req.indexOf(F("&S=")); //segment start
-  if (pos > 0) {
-    startI = std::abs(getNumVal(req, pos));
-  }
-  pos = req.indexOf(F("S2=")); //segment stop
-  if (pos > 0) {
-    stopI = std::abs(getNumVal(req, pos));
-  }
-  pos = req.indexOf(F("GP=")); //segment grouping
-  if (pos > 0) {
-    grpI = std::max(1,getNumVal(req, pos));
-  }
-  pos = req.indexOf(F("SP=")); //segment spacing
-  if (pos > 0) {
-    spcI = std::max(0,getNumVal(req, pos));
-  }
+  if (api.has(API_S))  startI = std::abs(api.num(API_S));     //segment start
+  if (api.has(API_S2)) stopI  = std::abs(api.num(API_S2));    //segment stop
+  if (api.has(API_GP)) grpI   = std::max(1,api.num(API_GP));  //segment grouping
+  if (api.has(API_SP)) spcI   = std::max(0,api.num(API_SP));  //segment spacing
   strip.suspend(); // must suspend strip operations before changing geometry
   selseg.setGeometry(startI, stopI, grpI, spcI, UINT16_MAX, startY, stopY, selseg.map1D2D);
   strip.resume();
 
-  pos = req.indexOf(F("RV=")); //Segment reverse
-  if (pos > 0) selseg.reverse = req.charAt(pos+3) != '0';
-
-  pos = req.indexOf(F("MI=")); //Segment mirror
-  if (pos > 0) selseg.mirror = req.charAt(pos+3) != '0';
+  if (api.has(API_RV)) selseg.reverse = api.flag(API_RV); //Segment reverse
+  if (api.has(API_MI)) selseg.mirror  = api.flag(API_MI); //Segment mirror
 
-  pos = req.indexOf(F("SB=")); //Segment brightness/opacity
-  if (pos > 0) {
-    byte segbri = getNumVal(req, pos);
+  if (api.has(API_SB)) { //Segment brightness/opacity
+    byte segbri = api.num(API_SB);
     selseg.setOption(SEG_OPTION_ON, segbri); // use transition
     if (segbri) {
       selseg.setOpacity(segbri);
     }
   }
 
-  pos = req.indexOf(F("SW=")); //segment power
-  if (pos > 0) {
-    switch (getNumVal(req, pos)) {
+  if (api.has(API_SW)) { //segment power
+    switch (api.num(API_SW)) {
       case 0:  selseg.setOption(SEG_OPTION_ON, false);      break; // use transition
       case 1:  selseg.setOption(SEG_OPTION_ON, true);       break; // use transition
       default: selseg.setOption(SEG_OPTION_ON, !selseg.on); break; // use transition
     }
   }
 
-  pos = req.indexOf(F("PS=")); //saves current in preset
-  if (pos > 0) savePreset(getNumVal(req, pos));
-
-  pos = req.indexOf(F("P1=")); //sets first preset for cycle
-  if (pos > 0) presetCycMin = getNumVal(req, pos);
-
-  pos = req.indexOf(F("P2=")); //sets last preset for cycle
-  if (pos > 0) presetCycMax = getNumVal(req, pos);
+  if (api.has(API_PS)) savePreset(api.num(API_PS));  //saves current in preset
+  if (api.has(API_P1)) presetCycMin = api.num(API_P1); //sets first preset for cycle
+  if (api.has(API_P2)) presetCycMax = api.num(API_P2); //sets last preset for cycle
 
   //apply preset
-  if (updateVal(req.c_str(), "PL=", presetCycCurr, presetCycMin, presetCycMax)) {
+  if (api.update(API_PL, presetCycCurr, presetCycMin, presetCycMax)) {
     applyPreset(presetCycCurr);
   }
 
-  pos = req.indexOf(F("NP")); //advances to next preset in a playlist
-  if (pos > 0) doAdvancePlaylist = true;
-  
+  if (api.present(API_NP)) doAdvancePlaylist = true; //advances to next preset in a playlist
+
   //set brightness
-  updateVal(req.c_str(), "&A=", bri);
+  api.update(API_A, bri);
 
   bool col0Changed = false, col1Changed = false, col2Changed = false;
   //set colors
-  col0Changed |= updateVal(req.c_str(), "&R=", colIn[0]);
-  col0Changed |= updateVal(req.c_str(), "&G=", colIn[1]);
-  col0Changed |= updateVal(req.c_str(), "&B=", colIn[2]);
-  col0Changed |= updateVal(req.c_str(), "&W=", colIn[3]);
+  col0Changed |= api.update(API_R, colIn[0]);
+  col0Changed |= api.update(API_G, colIn[1]);
+  col0Changed |= api.update(API_B, colIn[2]);
+  col0Changed |= api.update(API_W, colIn[3]);
 
-  col1Changed |= updateVal(req.c_str(), "R2=", colInSec[0]);
-  col1Changed |= updateVal(req.c_str(), "G2=", colInSec[1]);
-  col1Changed |= updateVal(req.c_str(), "B2=", colInSec[2]);
-  col1Changed |= updateVal(req.c_str(), "W2=", colInSec[3]);
+  col1Changed |= api.update(API_R2, colInSec[0]);
+  col1Changed |= api.update(API_G2, colInSec[1]);
+  col1Changed |= api.update(API_B2, colInSec[2]);
+  col1Changed |= api.update(API_W2, colInSec[3]);
 
   #ifdef WLED_ENABLE_LOXONE
   //lox parser
-  pos = req.indexOf(F("LX=")); // Lox primary color
-  if (pos > 0) {
-    int lxValue = getNumVal(req, pos);
+  if (api.has(API_LX)) { // Lox primary color
+    int lxValue = api.num(API_LX);
     if (parseLx(lxValue, colIn)) {
       bri = 255;
       nightlightActive = false; //always disable nightlight when toggling
       col0Changed = true;
     }
   }
-  pos = req.indexOf(F("LY=")); // Lox secondary color
-  if (pos > 0) {
-    int lxValue = getNumVal(req, pos);
+  if (api.has(API_LY)) { // Lox secondary color
+    int lxValue = api.num(API_LY);
     if(parseLx(lxValue, colInSec)) {
       bri = 255;
       nightlightActive = false; //always disable nightlight when toggling
@@ -984,51 +957,44 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply)
   #endif
 
   //set hue
-  pos = req.indexOf(F("HU="));
-  if (pos > 0) {
-    uint16_t temphue = getNumVal(req, pos);
+  if (api.has(API_HU)) {
+    uint16_t temphue = api.num(API_HU);
     byte tempsat = 255;
-    pos = req.indexOf(F("SA="));
-    if (pos > 0) {
-      tempsat = getNumVal(req, pos);
+    if (api.has(API_SA)) {
+      tempsat = api.num(API_SA);
     }
-    byte sec = req.indexOf(F("H2"));
-    colorHStoRGB(temphue, tempsat, (sec>0) ? colInSec : colIn);
+    bool sec = api.present(API_H2);
+    colorHStoRGB(temphue, tempsat, sec ? colInSec : colIn);
     col0Changed |= (!sec); col1Changed |= sec;
   }
 
   //set white spectrum (kelvin)
-  pos = req.indexOf(F("&K="));
-  if (pos > 0) {
-    byte sec = req.indexOf(F("K2"));
-    colorKtoRGB(getNumVal(req, pos), (sec>0) ? colInSec : colIn);
+  if (api.has(API_K)) {
+    bool sec = api.present(API_K2);
+    colorKtoRGB(api.num(API_K), sec ? colInSec : colIn);
     col0Changed |= (!sec); col1Changed |= sec;
   }
 
-  //set color from HEX or 32bit DEC
-  pos = req.indexOf(F("CL="));
-  if (pos > 0) {
-    colorFromDecOrHexString(colIn, (char*)req.substring(pos + 3).c_str());
+  //set color from HEX or 32bit DEC (parsing stops at the next '&')
+  if (api.has(API_CL)) {
+    colorFromDecOrHexString(colIn, api.value(API_CL));
     col0Changed = true;
   }
-  pos = req.indexOf(F("C2="));
-  if (pos > 0) {
-    colorFromDecOrHexString(colInSec, (char*)req.substring(pos + 3).c_str());
+  if (api.has(API_C2)) {
+    colorFromDecOrHexString(colInSec, api.value(API_C2));
     col1Changed = true;
   }
-  pos = req.indexOf(F("C3="));
-  if (pos > 0) {
+  if (api.has(API_C3)) {
     byte tmpCol[4];
-    colorFromDecOrHexString(tmpCol, (char*)req.substring(pos + 3).c_str());
+    colorFromDecOrHexString(tmpCol, api.value(API_C3));
     col2 = RGBW32(tmpCol[0], tmpCol[1], tmpCol[2], tmpCol[3]);
     selseg.setColor(2, col2); // defined above (SS= or main)
     col2Changed = true;
   }
 
   //set to random hue SR=0->1st SR=1->2nd
-  pos = req.indexOf(F("SR"));
-  if (pos > 0) {
-    byte sec = getNumVal(req, pos);
+  if (api.present(API_SR)) {
+    byte sec = api.has(API_SR) ? api.num(API_SR) : 0;
     setRandomColor(sec? colInSec : colIn);
     col0Changed |= (!sec); col1Changed |= sec;
   }
@@ -1045,8 +1011,7 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply)
   }
 
   //swap 2nd & 1st
-  pos = req.indexOf(F("SC"));
-  if (pos > 0) {
+  if (api.present(API_SC)) {
     std::swap(col0,col1);
     col0Changed = col1Changed = true;
   }
@@ -1054,19 +1019,19 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply)
   bool fxModeChanged = false, speedChanged = false, intensityChanged = false, paletteChanged = false;
   bool custom1Changed = false, custom2Changed = false, custom3Changed = false, check1Changed = false, check2Changed = false, check3Changed = false;
   // set effect parameters
-  if (updateVal(req.c_str(), "FX=", effectIn, 0, strip.getModeCount()-1)) {
+  if (api.update(API_FX, effectIn, 0, strip.getModeCount()-1)) {
     if (request != nullptr) unloadPlaylist(); // unload playlist if changing FX using web request
     fxModeChanged = true;
   }
-  speedChanged     = updateVal(req.c_str(), "SX=", speedIn);
-  intensityChanged = updateVal(req.c_str(), "IX=", intensityIn);
-  paletteChanged   = updateVal(req.c_str(), "FP=", paletteIn, 0, getPaletteCount()-1);
-  custom1Changed   = updateVal(req.c_str(), "X1=", custom1In);
-  custom2Changed   = updateVal(req.c_str(), "X2=", custom2In);
-  custom3Changed   = updateVal(req.c_str(), "X3=", custom3In);
-  check1Changed    = updateVal(req.c_str(), "M1=", check1In);
-  check2Changed    = updateVal(req.c_str(), "M2=", check2In);
-  check3Changed    = updateVal(req.c_str(), "M3=", check3In);
+  speedChanged     = api.update(API_SX, speedIn);
+  intensityChanged = api.update(API_IX, intensityIn);
+  paletteChanged   = api.update(API_FP, paletteIn, 0, getPaletteCount()-1);
+  custom1Changed   = api.update(API_X1, custom1In);
+  custom2Changed   = api.update(API_X2, custom2In);
+  custom3Changed   = api.update(API_X3, custom3In);
+  check1Changed    = api.update(API_M1, check1In);
+  check2Changed    = api.update(API_M2, check2In);
+  check3Changed    = api.update(API_M3, check3In);
 
   stateChanged |= (fxModeChanged || speedChanged || intensityChanged || paletteChanged || custom1Changed || custom2Changed || custom3Changed || check1Changed || check2Changed || check3Changed);
 
@@ -1074,7 +1039,7 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply)
   for (unsigned i = 0; i < strip.getSegmentsNum(); i++) {
     Segment& seg = strip.getSegment(i);
     if (i != selectedSeg && (singleSegment || !seg.isActive() || !seg.isSelected())) continue; // skip non main segments if not applying to all
-    if (fxModeChanged)    seg.setMode(effectIn, req.indexOf(F("FXD="))>0);  // apply defaults if FXD= is specified
+    if (fxModeChanged)    seg.setMode(effectIn, api.has(API_FXD));  // apply defaults if FXD= is specified
     if (speedChanged)     seg.speed     = speedIn;
     if (intensityChanged) seg.intensity = intensityIn;
     if (paletteChanged)   seg.setPalette(paletteIn);
@@ -1090,34 +1055,28 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply)
   }
 
   //set advanced overlay
-  pos = req.indexOf(F("OL="));
-  if (pos > 0) {
-    overlayCurrent = getNumVal(req, pos);
+  if (api.has(API_OL)) {
+    overlayCurrent = api.num(API_OL);
   }
 
   //apply macro (deprecated, added for compatibility with pre-0.11 automations)
-  pos = req.indexOf(F("&M="));
-  if (pos > 0) {
-    applyPreset(getNumVal(req, pos) + 16);
+  if (api.has(API_M)) {
+    applyPreset(api.num(API_M) + 16);
   }
 
   //toggle send UDP direct notifications
-  pos = req.indexOf(F("SN="));
-  if (pos > 0) notifyDirect = (req.charAt(pos+3) != '0');
+  if (api.has(API_SN)) notifyDirect = api.flag(API_SN);
 
   //toggle receive UDP direct notifications
-  pos = req.indexOf(F("RN="));
-  if (pos > 0) receiveGroups = (req.charAt(pos+3) != '0') ? receiveGroups | 1 : receiveGroups & 0xFE;
+  if (api.has(API_RN)) receiveGroups = api.flag(API_RN) ? receiveGroups | 1 : receiveGroups & 0xFE;
 
   //receive live data via UDP/Hyperion
-  pos = req.indexOf(F("RD="));
-  if (pos > 0) receiveDirect = (req.charAt(pos+3) != '0');
+  if (api.has(API_RD)) receiveDirect = api.flag(API_RD);
 
   //main toggle on/off (parse before nightlight, #1214)
-  pos = req.indexOf(F("&T="));
-  if (pos > 0) {
+  if (api.has(API_T)) {
     nightlightActive = false; //always disable nightlight when toggling
-    switch (getNumVal(req, pos))
+    switch (api.num(API_T))
     {
       case 0: if (bri != 0){briLast = bri; bri = 0;} break; //off, only if it was previously on
       case 1: if (bri == 0) bri = briLast; break; //on, only if it was previously off
@@ -1126,17 +1085,15 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply)
   }
 
   //toggle nightlight mode
-  bool aNlDef = false;
-  if (req.indexOf(F("&ND")) > 0) aNlDef = true;
-  pos = req.indexOf(F("NL="));
-  if (pos > 0)
+  bool aNlDef = api.present(API_ND);
+  if (api.has(API_NL))
   {
-    if (req.charAt(pos+3) == '0')
+    if (!api.flag(API_NL))
     {
       nightlightActive = false;
     } else {
       nightlightActive = true;
-      if (!aNlDef) nightlightDelayMins = getNumVal(req, pos);
+      if (!aNlDef) nightlightDelayMins = api.num(API_NL);
       else         nightlightDelayMins = nightlightDelayMinsDefault;
       nightlightStartTime = millis();
     }
@@ -1148,42 +1105,36 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply)
   }
 
   //set nightlight target brightness
-  pos = req.indexOf(F("NT="));
-  if (pos > 0) {
-    nightlightTargetBri = getNumVal(req, pos);
+  if (api.has(API_NT)) {
+    nightlightTargetBri = api.num(API_NT);
     nightlightActiveOld = false; //re-init
   }
 
   //toggle nightlight fade
-  pos = req.indexOf(F("NF="));
-  if (pos > 0)
+  if (api.has(API_NF))
   {
-    nightlightMode = getNumVal(req, pos);
+    nightlightMode = api.num(API_NF);
 
     nightlightActiveOld = false; //re-init
   }
   if (nightlightMode > NL_MODE_SUN) nightlightMode = NL_MODE_SUN;
 
-  pos = req.indexOf(F("TT="));
-  if (pos > 0) transitionDelay = getNumVal(req, pos);
+  if (api.has(API_TT)) transitionDelay = api.num(API_TT);
   strip.setTransition(transitionDelay);
 
   //set time (unix timestamp)
-  pos = req.indexOf(F("ST="));
-  if (pos > 0) {
-    setTimeFromAPI(getNumVal(req, pos));
+  if (api.has(API_ST)) {
+    setTimeFromAPI(api.num(API_ST));
   }
 
   //set countdown goal (unix timestamp)
-  pos = req.indexOf(F("CT="));
-  if (pos > 0) {
-    countdownTime = getNumVal(req, pos);
+  if (api.has(API_CT)) {
+    countdownTime = api.num(API_CT);
     if (countdownTime - toki.second() > 0) countdownOverTriggered = false;
   }
 
-  pos = req.indexOf(F("LO="));
-  if (pos > 0) {
-    realtimeOverride = getNumVal(req, pos);
+  if (api.has(API_LO)) {
+    realtimeOverride = api.num(API_LO);
     if (realtimeOverride > 2) realtimeOverride = REALTIME_OVERRIDE_ALWAYS;
     if (realtimeMode && useMainSegmentOnly) {
       strip.getMainSegment().freeze = !realtimeOverride;
@@ -1191,33 +1142,23 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply)
     }
   }
 
-  pos = req.indexOf(F("RB"));
-  if (pos > 0) doReboot = true;
+  if (api.present(API_RB)) doReboot = true;
 
   // clock mode, 0: normal, 1: countdown
-  pos = req.indexOf(F("NM="));
-  if (pos > 0) countdownMode = (req.charAt(pos+3) != '0');
+  if (api.has(API_NM)) countdownMode = api.flag(API_NM);
 
-  pos = req.indexOf(F("U0=")); //user var 0
-  if (pos > 0) {
-    userVar0 = getNumVal(req, pos);
-  }
-
-  pos = req.indexOf(F("U1=")); //user var 1
-  if (pos > 0) {
-    userVar1 = getNumVal(req, pos);
-  }
+  if (api.has(API_U0)) userVar0 = api.num(API_U0); //user var 0
+  if (api.has(API_U1)) userVar1 = api.num(API_U1); //user var 1
   // you can add more if you need
 
   // global colPri[], effectCurrent, ... are updated in stateChanged()
   if (!apply) return true; // when called by JSON API, do not call colorUpdated() here
 
-  pos = req.indexOf(F("&NN")); //do not send UDP notifications this time
-  stateUpdated((pos > 0) ? CALL_MODE_NO_NOTIFY : CALL_MODE_DIRECT_CHANGE);
+  //do not send UDP notifications this time
+  stateUpdated(api.present(API_NN) ? CALL_MODE_NO_NOTIFY : CALL_MODE_DIRECT_CHANGE);
 
   // internal call, does not send XML response
-  pos = req.indexOf(F("IN"));
-  if ((request != nullptr) && (pos < 1)) {
+  if ((request != nullptr) && !api.present(API_IN)) {
     auto response = request->beginResponseStream("text/xml");
     XML_response(*response);
     request->send(response);
@@ -205,17 +205,9 @@ uint8_t extractModeName(uint8_t mode, const char *src, char *dest, uint8_t maxLe
 {
   if (src == JSON_mode_names || src == nullptr) {
     if (mode < strip.getModeCount()) {
-      char lineBuffer[256];
-      //strcpy_P(lineBuffer, (const char*)pgm_read_dword(&(WS2812FX::_modeData[mode])));
-      strncpy_P(lineBuffer, strip.getModeData(mode), sizeof(lineBuffer)/sizeof(char)-1);
-      lineBuffer[sizeof(lineBuffer)/sizeof(char)-1] = '\0'; // terminate string
-      size_t len = strlen(lineBuffer);
-      size_t j = 0;
-      for (; j < maxLen && j < len; j++) {
-        if (lineBuffer[j] == '\0' || lineBuffer[j] == '@') break;
-        dest[j] = lineBuffer[j];
-      }
-      dest[j] = 0; // terminate string
+      size_t len = std::min((size_t)strip.getModeMeta(mode).nameLen, (size_t)maxLen); // name ends at '@' (index built in addEffect())
+      strncpy_P(dest, strip.getModeData(mode), len);
+      dest[len] = 0; // terminate string
       return strlen(dest);
     } else return 0;
   }
@@ -263,25 +255,27 @@ uint8_t extractModeSlider(uint8_t mode, uint8_t slider, char *dest, uint8_t maxL
   dest[0] = '\0'; // start by clearing buffer
 
   if (mode < strip.getModeCount()) {
-    String lineBuffer = FPSTR(strip.getModeData(mode));
-    if (lineBuffer.length() > 0) {
-      int start = lineBuffer.indexOf('@');   // String::indexOf() returns an int, not an unsigned; -1 means "not found"
-      int stop  = lineBuffer.indexOf(';', start);
-      if (start>0 && stop>0) {
-        String names = lineBuffer.substring(start, stop); // include @
-        int nameBegin = 1, nameEnd, nameDefault;
+    char lineBuffer[256];
+    strncpy_P(lineBuffer, strip.getModeData(mode), sizeof(lineBuffer)/sizeof(char)-1);
+    lineBuffer[sizeof(lineBuffer)/sizeof(char)-1] = '\0'; // terminate string
+    if (lineBuffer[0] != '\0') {
+      const mode_meta_t meta = strip.getModeMeta(mode);
+      if (meta.nameLen > 0 && meta.slidersEnd > 0) {
+        char *names = lineBuffer + meta.nameLen; // include @
+        names[meta.slidersEnd - meta.nameLen] = '\0'; // terminate slider names (palette search below uses lineBuffer beyond this point)
+        int nameBegin = 1;
         if (slider < 10) {
           for (size_t i=0; i<=slider; i++) {
-            const char *tmpstr;
             dest[0] = '\0'; //clear dest buffer
             if (nameBegin <= 0) break; // there are no more names
-            nameEnd = names.indexOf(',', nameBegin);
+            const char *nameEnd = strchr(names + nameBegin, ',');
             if (i == slider) {
-              nameDefault = names.indexOf('=', nameBegin); // find default value
-              if (nameDefault > 0 && var && ((nameEnd>0 && nameDefault<nameEnd) || nameEnd<0)) {
-                *var = (uint8_t)atoi(names.substring(nameDefault+1).c_str());
+              const char *nameDefault = strchr(names + nameBegin, '='); // find default value
+              if (nameDefault && var && (!nameEnd || nameDefault < nameEnd)) {
+                *var = (uint8_t)atoi(nameDefault+1);
               }
-              if (names.charAt(nameBegin) == '!') {
+              if (names[nameBegin] == '!') {
+                const char *tmpstr;
                 switch (slider) {
                   case  0: tmpstr = PSTR("FX Speed");     break;
                   case  1: tmpstr = PSTR("FX Intensity"); break;
@@ -293,24 +287,23 @@ uint8_t extractModeSlider(uint8_t mode, uint8_t slider, char *dest, uint8_t maxL
                 strncpy_P(dest, tmpstr, maxLen); // copy the name into buffer (replacing previous)
                 dest[maxLen-1] = '\0';
               } else {
-                if (nameEnd<0) tmpstr = names.substring(nameBegin).c_str(); // did not find ",", last name?
-                else           tmpstr = names.substring(nameBegin, nameEnd).c_str();
-                strlcpy(dest, tmpstr, maxLen); // copy the name into buffer (replacing previous)
+                size_t len = nameEnd ? nameEnd - (names + nameBegin) : strlen(names + nameBegin); // did not find ",", last name?
+                strlcpy(dest, names + nameBegin, std::min(len + 1, (size_t)maxLen)); // copy the name into buffer (replacing previous)
               }
             }
-            nameBegin = nameEnd+1; // next name (if "," is not found it will be 0)
+            nameBegin = nameEnd ? nameEnd - names + 1 : 0; // next name (if "," is not found it will be 0)
           } // next slider
         } else if (slider == 255) {
           // palette
           strlcpy(dest, "pal", maxLen);
-          names = lineBuffer.substring(stop+1); // stop has index of color slot names
-          nameBegin = names.indexOf(';'); // look for palette
-          if (nameBegin >= 0) {
-            nameEnd = names.indexOf(';', nameBegin+1);
-            if (!isdigit(names[nameBegin+1])) nameBegin = names.indexOf('=', nameBegin+1); // look for default value
-            if (nameEnd >= 0 && nameBegin > nameEnd) nameBegin = -1;
-            if (nameBegin >= 0 && var) {
-              *var = (uint8_t)atoi(names.substring(nameBegin+1).c_str());
+          const char *colors = lineBuffer + meta.slidersEnd + 1; // color slot names
+          const char *palBegin = strchr(colors, ';'); // look for palette
+          if (palBegin) {
+            const char *palEnd = strchr(palBegin+1, ';');
+            if (!isdigit(palBegin[1])) palBegin = strchr(palBegin+1, '='); // look for default value
+            if (palEnd && palBegin > palEnd) palBegin = nullptr;
+            if (palBegin && var) {
+              *var = (uint8_t)atoi(palBegin+1);
             }
           }
         }
@@ -336,19 +329,18 @@ uint8_t extractModeSlider(uint8_t mode, uint8_t slider, char *dest, uint8_t maxL
 int16_t extractModeDefaults(uint8_t mode, const char *segVar)
 {
   if (mode < strip.getModeCount()) {
-    char lineBuffer[256];
-    strncpy_P(lineBuffer, strip.getModeData(mode), sizeof(lineBuffer)/sizeof(char)-1);
+    unsigned startPos = strip.getModeMeta(mode).defaultsAt; // last ";" in FX data
+    if (startPos == 0) return -1;
+
+    char lineBuffer[128];
+    strncpy_P(lineBuffer, strip.getModeData(mode) + startPos, sizeof(lineBuffer)/sizeof(char)-1);
     lineBuffer[sizeof(lineBuffer)/sizeof(char)-1] = '\0'; // terminate string
-    if (lineBuffer[0] != 0) {
-      char* startPtr = strrchr(lineBuffer, ';'); // last ";" in FX data
-      if (!startPtr) return -1;
 
-      char* stopPtr = strstr(startPtr, segVar);
-      if (!stopPtr) return -1;
+    char* stopPtr = strstr(lineBuffer, segVar);
+    if (!stopPtr) return -1;
 
-      stopPtr += strlen(segVar) +1; // skip "="
-      return atoi(stopPtr);
-    }
+    stopPtr += strlen(segVar) +1; // skip "="
+    return atoi(stopPtr);
   }
   return -1;
 }
@@ -364,10 +356,9 @@ void checkSettingsPIN(const char* pin) {
 }
 
 
-uint16_t crc16(const unsigned char* data_p, size_t length) {
+uint16_t crc16(const unsigned char* data_p, size_t length, uint16_t crc) {
   uint8_t x;
-  uint16_t crc = 0xFFFF;
-  if (!length) return 0x1D0F;
+  if (!length) return crc == 0xFFFF ? 0x1D0F : crc;
   while (length--) {
     x = crc >> 8 ^ *data_p++;
     x ^= x>>4;
@@ -527,8 +518,14 @@ um_data_t* simulateSound(uint8_t simulationId)
   return um_data;
 }
 
+// records duration of a boot phase (finalizeInit() is also called after setup(), those calls are ignored)
+void bootPhaseDone(unsigned phase, unsigned long start) {
+  if (phase < BOOT_PHASES && !bootPhaseTime[BOOT_PHASE_TOTAL]) bootPhaseTime[phase] = millis() - start;
+}
+
 static const char s_ledmap_tmpl[] PROGMEM = "ledmap%d.json";
-// enumerate all ledmapX.json files on FS and extract ledmap names if existing
+static const char s_ledmap_bin_tmpl[] PROGMEM = "/ledmap%d.bin";
+// enumerate all ledmapX.json (and ledmapX.bin) files on FS and extract ledmap names if existing
 void enumerateLedmaps() {
   StaticJsonDocument<64> filter;
   filter["n"] = true;
@@ -536,7 +533,10 @@ void enumerateLedmaps() {
   for (size_t i=1; i<WLED_MAX_LEDMAPS; i++) {
     char fileName[33] = "/";
     sprintf_P(fileName+1, s_ledmap_tmpl, i);
-    bool isFile = WLED_FS.exists(fileName);
+    char binName[33];
+    sprintf_P(binName, s_ledmap_bin_tmpl, i);
+    bool isBinary = WLED_FS.exists(binName);
+    bool isFile = isBinary || WLED_FS.exists(fileName);
 
     #ifndef ESP8266
     if (ledmapNames[i-1]) { //clear old name
@@ -549,7 +549,20 @@ void enumerateLedmaps() {
       ledMaps |= 1 << i;
 
       #ifndef ESP8266
-      if (requestJSONBufferLock(21)) {
+      if (isBinary) {
+        ledmap_header_t hdr;
+        File f = WLED_FS.open(binName, "r");
+        if (f && f.read((uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr) && hdr.magic == LEDMAP_BIN_MAGIC) {
+          size_t len = strnlen(hdr.name, sizeof(hdr.name));
+          if (len == 0) len = strlen(strcpy(hdr.name, binName+1)); // use file name (fits into name)
+          ledmapNames[i-1] = static_cast<char*>(malloc(len+1));
+          if (ledmapNames[i-1]) {
+            memcpy(ledmapNames[i-1], hdr.name, len); // hdr.name is not NUL terminated if it uses all 32 characters
+            ledmapNames[i-1][len] = '\0';
+          }
+        }
+        f.close();
+      } else if (requestJSONBufferLock(21)) {
         if (readObjectFromFile(fileName, nullptr, pDoc, &filter)) {
           size_t len = 0;
           JsonObject root = pDoc->as<JsonObject>();
@@ -705,178 +718,3 @@ void *realloc_malloc(void *ptr, size_t size) {
   return malloc(size); // fallback to malloc
 }
 #endif
-
-/*
- * Fixed point integer based Perlin noise functions by @dedehai
- * Note: optimized for speed and to mimic fastled inoise functions, not for accuracy or best randomness
- */
-#define PERLIN_SHIFT 1
-
-// calculate gradient for corner from hash value
-static inline __attribute__((always_inline)) int32_t hashToGradient(uint32_t h) {
-  // using more steps yields more "detailed" perlin noise but looks less like the original fastled version (adjust PERLIN_SHIFT to compensate, also changes range and needs proper adustment)
-  // return (h & 0xFF) - 128; // use PERLIN_SHIFT 7
-  // return (h & 0x0F) - 8; // use PERLIN_SHIFT 3
-  // return (h & 0x07) - 4; // use PERLIN_SHIFT 2
-  return (h & 0x03) - 2; // use PERLIN_SHIFT 1 -> closest to original fastled version
-}
-
-// Gradient functions for 1D, 2D and 3D Perlin noise  note: forcing inline produces smaller code and makes it 3x faster!
-static inline __attribute__((always_inline)) int32_t gradient1D(uint32_t x0, int32_t dx) {
-  uint32_t h = x0 * 0x27D4EB2D;
-  h ^= h >> 15;
-  h *= 0x92C3412B;
-  h ^= h >> 13;
-  h ^= h >> 7;
-  return (hashToGradient(h) * dx) >> PERLIN_SHIFT;
-}
-
-static inline __attribute__((always_inline)) int32_t gradient2D(uint32_t x0, int32_t dx, uint32_t y0, int32_t dy) {
-  uint32_t h = (x0 * 0x27D4EB2D) ^ (y0 * 0xB5297A4D);
-  h ^= h >> 15;
-  h *= 0x92C3412B;
-  h ^= h >> 13;
-  return (hashToGradient(h) * dx + hashToGradient(h>>PERLIN_SHIFT) * dy) >> (1 + PERLIN_SHIFT);
-}
-
-static inline __attribute__((always_inline)) int32_t gradient3D(uint32_t x0, int32_t dx, uint32_t y0, int32_t dy, uint32_t z0, int32_t dz) {
-  // fast and good entropy hash from corner coordinates
-  uint32_t h = (x0 * 0x27D4EB2D) ^ (y0 * 0xB5297A4D) ^ (z0 * 0x1B56C4E9);
-  h ^= h >> 15;
-  h *= 0x92C3412B;
-  h ^= h >> 13;
-  return ((hashToGradient(h) * dx + hashToGradient(h>>(1+PERLIN_SHIFT)) * dy + hashToGradient(h>>(1 + 2*PERLIN_SHIFT)) * dz) * 85) >> (8 + PERLIN_SHIFT); // scale to 16bit, x*85 >> 8 = x/3
-}
-
-// fast cubic smoothstep: t*(3 - 2t²), optimized for fixed point, scaled to avoid overflows
-static uint32_t smoothstep(const uint32_t t) {
-  uint32_t t_squared = (t * t) >> 16;
-  uint32_t factor = (3 << 16) - ((t << 1));
-  return (t_squared * factor) >> 18; // scale to avoid overflows and give best resolution
-}
-
-// simple linear interpolation for fixed-point values, scaled for perlin noise use
-static inline int32_t lerpPerlin(int32_t a, int32_t b, int32_t t) {
-    return a + (((b - a) * t) >> 14); // match scaling with smoothstep to yield 16.16bit values
-}
-
-// 1D Perlin noise function that returns a value in range of -24691 to 24689
-int32_t perlin1D_raw(uint32_t x, bool is16bit) {
-  // integer and fractional part coordinates
-  int32_t x0 = x >> 16;
-  int32_t x1 = x0 + 1;
-  if(is16bit) x1 = x1 & 0xFF; // wrap back to zero at 0xFF instead of 0xFFFF
-
-  int32_t dx0 = x & 0xFFFF;
-  int32_t dx1 = dx0 - 0x10000;
-  // gradient values for the two corners
-  int32_t g0 = gradient1D(x0, dx0);
-  int32_t g1 = gradient1D(x1, dx1);
-  // interpolate and smooth function
-  int32_t tx = smoothstep(dx0);
-  int32_t noise = lerpPerlin(g0, g1, tx);
-  return noise;
-}
-
-// 2D Perlin noise function that returns a value in range of -20633 to 20629
-int32_t perlin2D_raw(uint32_t x, uint32_t y, bool is16bit) {
-  int32_t x0 = x >> 16;
-  int32_t y0 = y >> 16;
-  int32_t x1 = x0 + 1;
-  int32_t y1 = y0 + 1;
-
-  if(is16bit) {
-    x1 = x1 & 0xFF; // wrap back to zero at 0xFF instead of 0xFFFF
-    y1 = y1 & 0xFF;
-  }
-
-  int32_t dx0 = x & 0xFFFF;
-  int32_t dy0 = y & 0xFFFF;
-  int32_t dx1 = dx0 - 0x10000;
-  int32_t dy1 = dy0 - 0x10000;
-
-  int32_t g00 = gradient2D(x0, dx0, y0, dy0);
-  int32_t g10 = gradient2D(x1, dx1, y0, dy0);
-  int32_t g01 = gradient2D(x0, dx0, y1, dy1);
-  int32_t g11 = gradient2D(x1, dx1, y1, dy1);
-
-  uint32_t tx = smoothstep(dx0);
-  uint32_t ty = smoothstep(dy0);
-
-  int32_t nx0 = lerpPerlin(g00, g10, tx);
-  int32_t nx1 = lerpPerlin(g01, g11, tx);
-
-  int32_t noise = lerpPerlin(nx0, nx1, ty);
-  return noise;
-}
-
-// 3D Perlin noise function that returns a value in range of -16788 to 16381
-int32_t perlin3D_raw(uint32_t x, uint32_t y, uint32_t z, bool is16bit) {
-  int32_t x0 = x >> 16;
-  int32_t y0 = y >> 16;
-  int32_t z0 = z >> 16;
-  int32_t x1 = x0 + 1;
-  int32_t y1 = y0 + 1;
-  int32_t z1 = z0 + 1;
-
-  if(is16bit) {
-    x1 = x1 & 0xFF; // wrap back to zero at 0xFF instead of 0xFFFF
-    y1 = y1 & 0xFF;
-    z1 = z1 & 0xFF;
-  }
-
-  int32_t dx0 = x & 0xFFFF;
-  int32_t dy0 = y & 0xFFFF;
-  int32_t dz0 = z & 0xFFFF;
-  int32_t dx1 = dx0 - 0x10000;
-  int32_t dy1 = dy0 - 0x10000;
-  int32_t dz1 = dz0 - 0x10000;
-
-  int32_t g000 = gradient3D(x0, dx0, y0, dy0, z0, dz0);
-  int32_t g001 = gradient3D(x0, dx0, y0, dy0, z1, dz1);
-  int32_t g010 = gradient3D(x0, dx0, y1, dy1, z0, dz0);
-  int32_t g011 = gradient3D(x0, dx0, y1, dy1, z1, dz1);
-  int32_t g100 = gradient3D(x1, dx1, y0, dy0, z0, dz0);
-  int32_t g101 = gradient3D(x1, dx1, y0, dy0, z1, dz1);
-  int32_t g110 = gradient3D(x1, dx1, y1, dy1, z0, dz0);
-  int32_t g111 = gradient3D(x1, dx1, y1, dy1, z1, dz1);
-
-  uint32_t tx = smoothstep(dx0);
-  uint32_t ty = smoothstep(dy0);
-  uint32_t tz = smoothstep(dz0);
-
-  int32_t nx0 = lerpPerlin(g000, g100, tx);
-  int32_t nx1 = lerpPerlin(g010, g110, tx);
-  int32_t nx2 = lerpPerlin(g001, g101, tx);
-  int32_t nx3 = lerpPerlin(g011, g111, tx);
-  int32_t ny0 = lerpPerlin(nx0, nx1, ty);
-  int32_t ny1 = lerpPerlin(nx2, nx3, ty);
-
-  int32_t noise = lerpPerlin(ny0, ny1, tz);
-  return noise;
-}
-
-// scaling functions for fastled replacement
-uint16_t perlin16(uint32_t x) {
-  return ((perlin1D_raw(x) * 1159) >> 10) + 32803; //scale to 16bit and offset (fastled range: about 4838 to 60766)
-}
-
-uint16_t perlin16(uint32_t x, uint32_t y) {
- return ((perlin2D_raw(x, y) * 1537) >> 10) + 32725; //scale to 16bit and offset (fastled range: about 1748 to 63697)
-}
-
-uint16_t perlin16(uint32_t x, uint32_t y, uint32_t z) {
-  return ((perlin3D_raw(x, y, z) * 1731) >> 10) + 33147; //scale to 16bit and offset (fastled range: about 4766 to 60840)
-}
-
-uint8_t perlin8(uint16_t x) {
-  return (((perlin1D_raw((uint32_t)x << 8, true) * 1353) >> 10) + 32769) >> 8; //scale to 16 bit, offset, then scale to 8bit
-}
-
-uint8_t perlin8(uint16_t x, uint16_t y) {
-  return (((perlin2D_raw((uint32_t)x << 8, (uint32_t)y << 8, true) * 1620) >> 10) + 32771) >> 8; //scale to 16 bit, offset, then scale to 8bit
-}
-
-uint8_t perlin8(uint16_t x, uint16_t y, uint16_t z) {
-  return (((perlin3D_raw((uint32_t)x << 8, (uint32_t)y << 8, (uint32_t)z << 8, true) * 2015) >> 10) + 33168) >> 8; //scale to 16 bit, offset, then scale to 8bit
-}
\ No newline at end of file
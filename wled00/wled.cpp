@@ -123,6 +123,10 @@ void WLED::loop()
     handlePresets();
     yield();
 
+    #ifdef WLED_ENABLE_GIF
+    prefetchVideoFrames();
+    #endif
+
     if (!offMode || strip.isOffRefreshRequired() || strip.needsUpdate())
       strip.service();
     #ifdef ESP8266
@@ -396,6 +400,7 @@ void WLED::setup()
 
   DEBUG_PRINTF_P(PSTR("heap %u\n"), ESP.getFreeHeap());
 
+  unsigned long phaseStart = millis();
   bool fsinit = false;
   DEBUGFS_PRINTLN(F("Mount FS"));
 #ifdef ARDUINO_ARCH_ESP32
@@ -413,6 +418,8 @@ void WLED::setup()
   initPresetsFile();
 #endif
   updateFSInfo();
+  initFileCache();
+  bootPhaseDone(BOOT_PHASE_FS, phaseStart);
 
   // generate module IDs must be done before AP setup
   escapedMac = WiFi.macAddress();
@@ -423,7 +430,9 @@ void WLED::setup()
   multiWiFi.push_back(WiFiConfig(CLIENT_SSID,CLIENT_PASS)); // initialise vector with default WiFi
 
   DEBUG_PRINTLN(F("Reading config"));
+  phaseStart = millis();
   bool needsCfgSave = deserializeConfigFromFS();
+  bootPhaseDone(BOOT_PHASE_CFG, phaseStart);
   DEBUG_PRINTF_P(PSTR("heap %u\n"), ESP.getFreeHeap());
 
 #if defined(STATUSLED) && STATUSLED>=0
@@ -435,12 +444,17 @@ void WLED::setup()
 #endif
 
   DEBUG_PRINTLN(F("Initializing strip"));
+  phaseStart = millis();
   beginStrip();
+  bootPhaseDone(BOOT_PHASE_STRIP, phaseStart);
+  bootPhaseDone(BOOT_PHASE_LIGHT);
   DEBUG_PRINTF_P(PSTR("heap %u\n"), ESP.getFreeHeap());
 
   DEBUG_PRINTLN(F("Usermods setup"));
+  phaseStart = millis();
   userSetup();
   UsermodManager::setup();
+  bootPhaseDone(BOOT_PHASE_USERMODS, phaseStart);
   DEBUG_PRINTF_P(PSTR("heap %u\n"), ESP.getFreeHeap());
 
   if (needsCfgSave) serializeConfigToFS(); // usermods required new parameters; need to wait for strip to be initialised #4752
@@ -505,7 +519,9 @@ void WLED::setup()
 
   // HTTP server page init
   DEBUG_PRINTLN(F("initServer"));
+  phaseStart = millis();
   initServer();
+  bootPhaseDone(BOOT_PHASE_SERVER, phaseStart);
   DEBUG_PRINTF_P(PSTR("heap %u\n"), ESP.getFreeHeap());
 
 #ifndef WLED_DISABLE_INFRARED
@@ -526,6 +542,8 @@ void WLED::setup()
   #if defined(ARDUINO_ARCH_ESP32) && defined(WLED_DISABLE_BROWNOUT_DET)
   WRITE_PERI_REG(RTC_CNTL_BROWN_OUT_REG, 1); //enable brownout detector
   #endif
+  bootPhaseDone(BOOT_PHASE_TOTAL); // must be last, stops recording
+  DEBUG_PRINTF_P(PSTR("Boot took %ums (light after %ums).\n"), bootPhaseTime[BOOT_PHASE_TOTAL], bootPhaseTime[BOOT_PHASE_LIGHT]);
 }
 
 void WLED::beginStrip()
@@ -885,6 +885,10 @@ WLED_GLOBAL size_t fsBytesTotal _INIT(0);
 WLED_GLOBAL unsigned long presetsModifiedTime _INIT(0L);
 WLED_GLOBAL bool doCloseFile _INIT(false);
 
+// boot profiling
+WLED_GLOBAL uint16_t bootPhaseTime[BOOT_PHASES] _INIT_N(({0})); // duration of each boot phase in ms (see BOOT_PHASE_*)
+WLED_GLOBAL byte bootSnapshot _INIT(0);                          // BOOT_SNAPSHOT_* flags of data restored from snapshot
+
 // presets
 WLED_GLOBAL byte currentPreset _INIT(0);
 
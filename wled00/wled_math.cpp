@@ -1,5 +1,5 @@
 /*
- * Contains some trigonometric functions.
+ * Contains some trigonometric functions and the Perlin noise functions.
  * The ANSI C equivalents are likely faster, but using any sin/cos/tan function incurs a memory penalty of 460 bytes on ESP8266, likely for lookup tables.
  * This implementation has no extra static memory usage.
  *
@@ -7,6 +7,7 @@
  */
 
 #include <Arduino.h> //PI constant
+#include "wled_math.h"
 
 //#define WLED_DEBUG_MATH
 
@@ -244,3 +245,329 @@ uint32_t sqrt32_bw(uint32_t x) {
   }
   return res;
 }
+
+/*
+ * Fixed point integer based Perlin noise functions by @dedehai
+ * Note: optimized for speed and to mimic fastled inoise functions, not for accuracy or best randomness
+ */
+#define PERLIN_SHIFT 1
+
+// calculate gradient for corner from hash value
+static inline __attribute__((always_inline)) int32_t hashToGradient(uint32_t h) {
+  // using more steps yields more "detailed" perlin noise but looks less like the original fastled version (adjust PERLIN_SHIFT to compensate, also changes range and needs proper adustment)
+  // return (h & 0xFF) - 128; // use PERLIN_SHIFT 7
+  // return (h & 0x0F) - 8; // use PERLIN_SHIFT 3
+  // return (h & 0x07) - 4; // use PERLIN_SHIFT 2
+  return (h & 0x03) - 2; // use PERLIN_SHIFT 1 -> closest to original fastled version
+}
+
+// Gradient functions for 1D, 2D and 3D Perlin noise  note: forcing inline produces smaller code and makes it 3x faster!
+static inline __attribute__((always_inline)) int32_t gradient1D(uint32_t x0, int32_t dx) {
+  uint32_t h = x0 * 0x27D4EB2D;
+  h ^= h >> 15;
+  h *= 0x92C3412B;
+  h ^= h >> 13;
+  h ^= h >> 7;
+  return (hashToGradient(h) * dx) >> PERLIN_SHIFT;
+}
+
+// hash mixing for 2D and 3D corner hashes
+static inline __attribute__((always_inline)) uint32_t mixPerlinHash(uint32_t h) {
+  h ^= h >> 15;
+  h *= 0x92C3412B;
+  h ^= h >> 13;
+  return h;
+}
+
+static inline __attribute__((always_inline)) int32_t gradient2D(uint32_t x0, int32_t dx, uint32_t y0, int32_t dy) {
+  uint32_t h = mixPerlinHash((x0 * 0x27D4EB2D) ^ (y0 * 0xB5297A4D));
+  return (hashToGradient(h) * dx + hashToGradient(h>>PERLIN_SHIFT) * dy) >> (1 + PERLIN_SHIFT);
+}
+
+static inline __attribute__((always_inline)) int32_t gradient3D(uint32_t x0, int32_t dx, uint32_t y0, int32_t dy, uint32_t z0, int32_t dz) {
+  // fast and good entropy hash from corner coordinates
+  uint32_t h = mixPerlinHash((x0 * 0x27D4EB2D) ^ (y0 * 0xB5297A4D) ^ (z0 * 0x1B56C4E9));
+  return ((hashToGradient(h) * dx + hashToGradient(h>>(1+PERLIN_SHIFT)) * dy + hashToGradient(h>>(1 + 2*PERLIN_SHIFT)) * dz) * 85) >> (8 + PERLIN_SHIFT); // scale to 16bit, x*85 >> 8 = x/3
+}
+
+// fast cubic smoothstep: t*(3 - 2t²), optimized for fixed point, scaled to avoid overflows
+static uint32_t smoothstep(const uint32_t t) {
+  uint32_t t_squared = (t * t) >> 16;
+  uint32_t factor = (3 << 16) - ((t << 1));
+  return (t_squared * factor) >> 18; // scale to avoid overflows and give best resolution
+}
+
+// simple linear interpolation for fixed-point values, scaled for perlin noise use
+static inline int32_t lerpPerlin(int32_t a, int32_t b, int32_t t) {
+    return a + (((b - a) * t) >> 14); // match scaling with smoothstep to yield 16.16bit values
+}
+
+// 1D Perlin noise function that returns a value in range of -24691 to 24689
+int32_t perlin1D_raw(uint32_t x, bool is16bit) {
+  // integer and fractional part coordinates
+  int32_t x0 = x >> 16;
+  int32_t x1 = x0 + 1;
+  if(is16bit) x1 = x1 & 0xFF; // wrap back to zero at 0xFF instead of 0xFFFF
+
+  int32_t dx0 = x & 0xFFFF;
+  int32_t dx1 = dx0 - 0x10000;
+  // gradient values for the two corners
+  int32_t g0 = gradient1D(x0, dx0);
+  int32_t g1 = gradient1D(x1, dx1);
+  // interpolate and smooth function
+  int32_t tx = smoothstep(dx0);
+  int32_t noise = lerpPerlin(g0, g1, tx);
+  return noise;
+}
+
+// 2D Perlin noise function that returns a value in range of -20633 to 20629
+int32_t perlin2D_raw(uint32_t x, uint32_t y, bool is16bit) {
+  int32_t x0 = x >> 16;
+  int32_t y0 = y >> 16;
+  int32_t x1 = x0 + 1;
+  int32_t y1 = y0 + 1;
+
+  if(is16bit) {
+    x1 = x1 & 0xFF; // wrap back to zero at 0xFF instead of 0xFFFF
+    y1 = y1 & 0xFF;
+  }
+
+  int32_t dx0 = x & 0xFFFF;
+  int32_t dy0 = y & 0xFFFF;
+  int32_t dx1 = dx0 - 0x10000;
+  int32_t dy1 = dy0 - 0x10000;
+
+  int32_t g00 = gradient2D(x0, dx0, y0, dy0);
+  int32_t g10 = gradient2D(x1, dx1, y0, dy0);
+  int32_t g01 = gradient2D(x0, dx0, y1, dy1);
+  int32_t g11 = gradient2D(x1, dx1, y1, dy1);
+
+  uint32_t tx = smoothstep(dx0);
+  uint32_t ty = smoothstep(dy0);
+
+  int32_t nx0 = lerpPerlin(g00, g10, tx);
+  int32_t nx1 = lerpPerlin(g01, g11, tx);
+
+  int32_t noise = lerpPerlin(nx0, nx1, ty);
+  return noise;
+}
+
+// 3D Perlin noise function that returns a value in range of -16788 to 16381
+int32_t perlin3D_raw(uint32_t x, uint32_t y, uint32_t z, bool is16bit) {
+  int32_t x0 = x >> 16;
+  int32_t y0 = y >> 16;
+  int32_t z0 = z >> 16;
+  int32_t x1 = x0 + 1;
+  int32_t y1 = y0 + 1;
+  int32_t z1 = z0 + 1;
+
+  if(is16bit) {
+    x1 = x1 & 0xFF; // wrap back to zero at 0xFF instead of 0xFFFF
+    y1 = y1 & 0xFF;
+    z1 = z1 & 0xFF;
+  }
+
+  int32_t dx0 = x & 0xFFFF;
+  int32_t dy0 = y & 0xFFFF;
+  int32_t dz0 = z & 0xFFFF;
+  int32_t dx1 = dx0 - 0x10000;
+  int32_t dy1 = dy0 - 0x10000;
+  int32_t dz1 = dz0 - 0x10000;
+
+  int32_t g000 = gradient3D(x0, dx0, y0, dy0, z0, dz0);
+  int32_t g001 = gradient3D(x0, dx0, y0, dy0, z1, dz1);
+  int32_t g010 = gradient3D(x0, dx0, y1, dy1, z0, dz0);
+  int32_t g011 = gradient3D(x0, dx0, y1, dy1, z1, dz1);
+  int32_t g100 = gradient3D(x1, dx1, y0, dy0, z0, dz0);
+  int32_t g101 = gradient3D(x1, dx1, y0, dy0, z1, dz1);
+  int32_t g110 = gradient3D(x1, dx1, y1, dy1, z0, dz0);
+  int32_t g111 = gradient3D(x1, dx1, y1, dy1, z1, dz1);
+
+  uint32_t tx = smoothstep(dx0);
+  uint32_t ty = smoothstep(dy0);
+  uint32_t tz = smoothstep(dz0);
+
+  int32_t nx0 = lerpPerlin(g000, g100, tx);
+  int32_t nx1 = lerpPerlin(g010, g110, tx);
+  int32_t nx2 = lerpPerlin(g001, g101, tx);
+  int32_t nx3 = lerpPerlin(g011, g111, tx);
+  int32_t ny0 = lerpPerlin(nx0, nx1, ty);
+  int32_t ny1 = lerpPerlin(nx2, nx3, ty);
+
+  int32_t noise = lerpPerlin(ny0, ny1, tz);
+  return noise;
+}
+
+/*
+ * Perlin noise along a line: sample i is taken at (x + i*stepX, y + i*stepY[, z + i*stepZ]), results are identical to perlin2D_raw()/perlin3D_raw()
+ * corner gradients only depend on the lattice cell and are only recalculated when a sample enters a new cell (usually every few pixels)
+ * coordinates are masked with coordMask to emulate 16bit coordinate overflow of perlin8()
+ */
+template <typename Store>
+static inline __attribute__((always_inline)) void perlin2DLine(unsigned count, uint32_t x, uint32_t y, uint32_t stepX, uint32_t stepY, bool is16bit, uint32_t coordMask, Store store) {
+  int32_t cellX = -1, cellY = -1; // current lattice cell (coordinates are always positive)
+  int32_t gx[4], gy[4];           // gradients of corners 00, 10, 01, 11
+  const bool row = (stepY == 0);  // y is constant: y part of the gradients and y smoothstep only change with the cell
+  int32_t gyDy[4];
+  uint32_t ty = 0;
+  for (unsigned i = 0; i < count; i++, x += stepX, y += stepY) {
+    const uint32_t px = x & coordMask;
+    const uint32_t py = y & coordMask;
+    const int32_t x0 = px >> 16;
+    const int32_t y0 = py >> 16;
+    if (x0 != cellX || y0 != cellY) {
+      cellX = x0;
+      cellY = y0;
+      int32_t x1 = x0 + 1;
+      int32_t y1 = y0 + 1;
+      if (is16bit) {
+        x1 = x1 & 0xFF; // wrap back to zero at 0xFF instead of 0xFFFF
+        y1 = y1 & 0xFF;
+      }
+      const uint32_t hx[2] = { uint32_t(x0) * 0x27D4EB2D, uint32_t(x1) * 0x27D4EB2D };
+      const uint32_t hy[2] = { uint32_t(y0) * 0xB5297A4D, uint32_t(y1) * 0xB5297A4D };
+      for (int c = 0; c < 4; c++) {
+        uint32_t h = mixPerlinHash(hx[c & 1] ^ hy[c >> 1]);
+        gx[c] = hashToGradient(h);
+        gy[c] = hashToGradient(h >> PERLIN_SHIFT);
+      }
+      if (row) {
+        const int32_t dy0 = py & 0xFFFF;
+        for (int c = 0; c < 4; c++) gyDy[c] = gy[c] * ((c & 2) ? dy0 - 0x10000 : dy0);
+        ty = smoothstep(dy0);
+      }
+    }
+    const int32_t dx0 = px & 0xFFFF;
+    const int32_t dx1 = dx0 - 0x10000;
+    if (!row) {
+      const int32_t dy0 = py & 0xFFFF;
+      for (int c = 0; c < 4; c++) gyDy[c] = gy[c] * ((c & 2) ? dy0 - 0x10000 : dy0);
+      ty = smoothstep(dy0);
+    }
+
+    int32_t g00 = (gx[0] * dx0 + gyDy[0]) >> (1 + PERLIN_SHIFT);
+    int32_t g10 = (gx[1] * dx1 + gyDy[1]) >> (1 + PERLIN_SHIFT);
+    int32_t g01 = (gx[2] * dx0 + gyDy[2]) >> (1 + PERLIN_SHIFT);
+    int32_t g11 = (gx[3] * dx1 + gyDy[3]) >> (1 + PERLIN_SHIFT);
+
+    uint32_t tx = smoothstep(dx0);
+
+    int32_t nx0 = lerpPerlin(g00, g10, tx);
+    int32_t nx1 = lerpPerlin(g01, g11, tx);
+    store(i, lerpPerlin(nx0, nx1, ty));
+  }
+}
+
+template <typename Store>
+static inline __attribute__((always_inline)) void perlin3DLine(unsigned count, uint32_t x, uint32_t y, uint32_t z, uint32_t stepX, uint32_t stepY, uint32_t stepZ, bool is16bit, uint32_t coordMask, Store store) {
+  int32_t cellX = -1, cellY = -1, cellZ = -1; // current lattice cell (coordinates are always positive)
+  int32_t gx[8], gy[8], gz[8];                // gradients of corners, index bits: z y x (i.e. 0 = 000, 1 = 100, 2 = 010, ...)
+  const bool row = (stepY == 0 && stepZ == 0); // y and z are constant: their gradient parts and smoothsteps only change with the cell
+  int32_t gyz[8];
+  uint32_t ty = 0, tz = 0;
+  const auto yzPart = [&](uint32_t py, uint32_t pz) {
+    const int32_t dy0 = py & 0xFFFF;
+    const int32_t dz0 = pz & 0xFFFF;
+    for (int c = 0; c < 8; c++) gyz[c] = gy[c] * ((c & 2) ? dy0 - 0x10000 : dy0) + gz[c] * ((c & 4) ? dz0 - 0x10000 : dz0);
+    ty = smoothstep(dy0);
+    tz = smoothstep(dz0);
+  };
+  for (unsigned i = 0; i < count; i++, x += stepX, y += stepY, z += stepZ) {
+    const uint32_t px = x & coordMask;
+    const uint32_t py = y & coordMask;
+    const uint32_t pz = z & coordMask;
+    const int32_t x0 = px >> 16;
+    const int32_t y0 = py >> 16;
+    const int32_t z0 = pz >> 16;
+    if (x0 != cellX || y0 != cellY || z0 != cellZ) {
+      cellX = x0;
+      cellY = y0;
+      cellZ = z0;
+      int32_t x1 = x0 + 1;
+      int32_t y1 = y0 + 1;
+      int32_t z1 = z0 + 1;
+      if (is16bit) {
+        x1 = x1 & 0xFF; // wrap back to zero at 0xFF instead of 0xFFFF
+        y1 = y1 & 0xFF;
+        z1 = z1 & 0xFF;
+      }
+      const uint32_t hx[2] = { uint32_t(x0) * 0x27D4EB2D, uint32_t(x1) * 0x27D4EB2D };
+      const uint32_t hy[2] = { uint32_t(y0) * 0xB5297A4D, uint32_t(y1) * 0xB5297A4D };
+      const uint32_t hz[2] = { uint32_t(z0) * 0x1B56C4E9, uint32_t(z1) * 0x1B56C4E9 };
+      for (int c = 0; c < 8; c++) {
+        uint32_t h = mixPerlinHash(hx[c & 1] ^ hy[(c >> 1) & 1] ^ hz[c >> 2]);
+        gx[c] = hashToGradient(h);
+        gy[c] = hashToGradient(h >> (1 + PERLIN_SHIFT));
+        gz[c] = hashToGradient(h >> (1 + 2*PERLIN_SHIFT));
+      }
+      if (row) yzPart(py, pz);
+    }
+    if (!row) yzPart(py, pz);
+    const int32_t dx0 = px & 0xFFFF;
+    const int32_t dx1 = dx0 - 0x10000;
+    int32_t g[8];
+    for (int c = 0; c < 8; c++) g[c] = ((gx[c] * ((c & 1) ? dx1 : dx0) + gyz[c]) * 85) >> (8 + PERLIN_SHIFT); // same as gradient3D()
+
+    uint32_t tx = smoothstep(dx0);
+
+    int32_t nx0 = lerpPerlin(g[0], g[1], tx);
+    int32_t nx1 = lerpPerlin(g[2], g[3], tx);
+    int32_t nx2 = lerpPerlin(g[4], g[5], tx);
+    int32_t nx3 = lerpPerlin(g[6], g[7], tx);
+    int32_t ny0 = lerpPerlin(nx0, nx1, ty);
+    int32_t ny1 = lerpPerlin(nx2, nx3, ty);
+    store(i, lerpPerlin(ny0, ny1, tz));
+  }
+}
+
+void perlin2D_rawLine(int32_t *out, unsigned count, uint32_t x, uint32_t y, int32_t stepX, int32_t stepY, bool is16bit) {
+  perlin2DLine(count, x, y, stepX, stepY, is16bit, 0xFFFFFFFF, [out](unsigned i, int32_t n) { out[i] = n; });
+}
+
+void perlin3D_rawLine(int32_t *out, unsigned count, uint32_t x, uint32_t y, uint32_t z, int32_t stepX, int32_t stepY, int32_t stepZ, bool is16bit) {
+  perlin3DLine(count, x, y, z, stepX, stepY, stepZ, is16bit, 0xFFFFFFFF, [out](unsigned i, int32_t n) { out[i] = n; });
+}
+
+// line versions of perlin16() and perlin8(), scaling is the same as in the single value functions below
+void perlin16Line(uint16_t *out, unsigned count, uint32_t x, uint32_t y, int32_t stepX, int32_t stepY) {
+  perlin2DLine(count, x, y, stepX, stepY, false, 0xFFFFFFFF, [out](unsigned i, int32_t n) { out[i] = ((n * 1537) >> 10) + 32725; });
+}
+
+void perlin16Line(uint16_t *out, unsigned count, uint32_t x, uint32_t y, uint32_t z, int32_t stepX, int32_t stepY, int32_t stepZ) {
+  perlin3DLine(count, x, y, z, stepX, stepY, stepZ, false, 0xFFFFFFFF, [out](unsigned i, int32_t n) { out[i] = ((n * 1731) >> 10) + 33147; });
+}
+
+void perlin8Line(uint8_t *out, unsigned count, uint16_t x, uint16_t y, int stepX, int stepY) {
+  perlin2DLine(count, (uint32_t)x << 8, (uint32_t)y << 8, (uint32_t)stepX << 8, (uint32_t)stepY << 8, true, 0x00FFFFFF,
+               [out](unsigned i, int32_t n) { out[i] = (((n * 1620) >> 10) + 32771) >> 8; });
+}
+
+void perlin8Line(uint8_t *out, unsigned count, uint16_t x, uint16_t y, uint16_t z, int stepX, int stepY, int stepZ) {
+  perlin3DLine(count, (uint32_t)x << 8, (uint32_t)y << 8, (uint32_t)z << 8, (uint32_t)stepX << 8, (uint32_t)stepY << 8, (uint32_t)stepZ << 8, true, 0x00FFFFFF,
+               [out](unsigned i, int32_t n) { out[i] = (((n * 2015) >> 10) + 33168) >> 8; });
+}
+
+// scaling functions for fastled replacement
+uint16_t perlin16(uint32_t x) {
+  return ((perlin1D_raw(x) * 1159) >> 10) + 32803; //scale to 16bit and offset (fastled range: about 4838 to 60766)
+}
+
+uint16_t perlin16(uint32_t x, uint32_t y) {
+ return ((perlin2D_raw(x, y) * 1537) >> 10) + 32725; //scale to 16bit and offset (fastled range: about 1748 to 63697)
+}
+
+uint16_t perlin16(uint32_t x, uint32_t y, uint32_t z) {
+  return ((perlin3D_raw(x, y, z) * 1731) >> 10) + 33147; //scale to 16bit and offset (fastled range: about 4766 to 60840)
+}
+
+uint8_t perlin8(uint16_t x) {
+  return (((perlin1D_raw((uint32_t)x << 8, true) * 1353) >> 10) + 32769) >> 8; //scale to 16 bit, offset, then scale to 8bit
+}
+
+uint8_t perlin8(uint16_t x, uint16_t y) {
+  return (((perlin2D_raw((uint32_t)x << 8, (uint32_t)y << 8, true) * 1620) >> 10) + 32771) >> 8; //scale to 16 bit, offset, then scale to 8bit
+}
+
+uint8_t perlin8(uint16_t x, uint16_t y, uint16_t z) {
+  return (((perlin3D_raw((uint32_t)x << 8, (uint32_t)y << 8, (uint32_t)z << 8, true) * 2015) >> 10) + 33168) >> 8; //scale to 16 bit, offset, then scale to 8bit
+}
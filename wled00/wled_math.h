@@ -0,0 +1,60 @@
+#pragma once
+#ifndef WLED_MATH_H
+#define WLED_MATH_H
+
+/*
+ * Integer and approximated float math functions and Perlin noise (wled_math.cpp)
+ */
+
+#include <stdint.h>
+
+//float cos_t(float phi); // use float math
+//float sin_t(float phi);
+//float tan_t(float x);
+int16_t sin16_t(uint16_t theta);
+int16_t cos16_t(uint16_t theta);
+uint8_t sin8_t(uint8_t theta);
+uint8_t cos8_t(uint8_t theta);
+float sin_approx(float theta); // uses integer math (converted to float), accuracy +/-0.0015 (compared to sinf())
+float cos_approx(float theta);
+float tan_approx(float x);
+float atan2_t(float y, float x);
+float acos_t(float x);
+float asin_t(float x);
+template <typename T> T atan_t(T x);
+float floor_t(float x);
+float fmod_t(float num, float denom);
+uint32_t sqrt32_bw(uint32_t x);
+int32_t perlin1D_raw(uint32_t x, bool is16bit = false);
+int32_t perlin2D_raw(uint32_t x, uint32_t y, bool is16bit = false);
+int32_t perlin3D_raw(uint32_t x, uint32_t y, uint32_t z, bool is16bit = false);
+uint16_t perlin16(uint32_t x);
+uint16_t perlin16(uint32_t x, uint32_t y);
+uint16_t perlin16(uint32_t x, uint32_t y, uint32_t z);
+uint8_t perlin8(uint16_t x);
+uint8_t perlin8(uint16_t x, uint16_t y);
+uint8_t perlin8(uint16_t x, uint16_t y, uint16_t z);
+// noise along a line, sample i is taken at (x + i*stepX, y + i*stepY[, z + i*stepZ]), same values as the single sample functions
+void perlin2D_rawLine(int32_t *out, unsigned count, uint32_t x, uint32_t y, int32_t stepX, int32_t stepY, bool is16bit = false);
+void perlin3D_rawLine(int32_t *out, unsigned count, uint32_t x, uint32_t y, uint32_t z, int32_t stepX, int32_t stepY, int32_t stepZ, bool is16bit = false);
+void perlin16Line(uint16_t *out, unsigned count, uint32_t x, uint32_t y, int32_t stepX, int32_t stepY);
+void perlin16Line(uint16_t *out, unsigned count, uint32_t x, uint32_t y, uint32_t z, int32_t stepX, int32_t stepY, int32_t stepZ);
+void perlin8Line(uint8_t *out, unsigned count, uint16_t x, uint16_t y, int stepX, int stepY);
+void perlin8Line(uint8_t *out, unsigned count, uint16_t x, uint16_t y, uint16_t z, int stepX, int stepY, int stepZ);
+#define sin_t sin_approx
+#define cos_t cos_approx
+#define tan_t tan_approx
+
+/*
+#include <math.h>  // standard math functions. use a lot of flash
+#define sin_t sinf
+#define cos_t cosf
+#define tan_t tanf
+#define asin_t asinf
+#define acos_t acosf
+#define atan_t atanf
+#define fmod_t fmodf
+#define floor_t floorf
+*/
+
+#endif
@@ -61,7 +61,7 @@ static void generateEtag(char *etag, uint16_t eTagSuffix) {
   sprintf_P(etag, PSTR("%7d-%02x-%04x"), VERSION, cacheInvalidate, eTagSuffix);
 }
 
-static void setStaticContentCacheHeaders(AsyncWebServerResponse *response, int code, uint16_t eTagSuffix = 0) {
+void setStaticContentCacheHeaders(AsyncWebServerResponse *response, int code, uint16_t eTagSuffix) {
   // Only send ETag for 200 (OK) responses
   if (code != 200) return;
 
@@ -78,7 +78,7 @@ static void setStaticContentCacheHeaders(AsyncWebServerResponse *response, int c
   response->addHeader(F("ETag"), etag);
 }
 
-static bool handleIfNoneMatchCacheHeader(AsyncWebServerRequest *request, int code, uint16_t eTagSuffix = 0) {
+bool handleIfNoneMatchCacheHeader(AsyncWebServerRequest *request, int code, uint16_t eTagSuffix) {
   // Only send 304 (Not Modified) if response code is 200 (OK)
   if (code != 200) return false;
 
@@ -187,7 +187,10 @@ static void handleUpload(AsyncWebServerRequest *request, const String& filename,
 
     request->_tempFile = WLED_FS.open(finalname, "w");
     DEBUG_PRINTF_P(PSTR("Uploading %s\n"), finalname.c_str());
-    if (finalname.equals(FPSTR(getPresetsFileName()))) presetsModifiedTime = toki.second();
+    if (finalname.equals(FPSTR(getPresetsFileName()))) {
+      presetsModifiedTime = toki.second();
+      invalidatePresetIndex();
+    }
   }
   if (len) {
     request->_tempFile.write(data,len);
@@ -205,14 +208,46 @@ static void handleUpload(AsyncWebServerRequest *request, const String& filename,
   }
 }
 
+#ifdef WLED_ENABLE_FS_EDITOR
+// called after the /edit handler wrote, created or deleted a file
+static void editorFileChanged(const String &path) {
+  invalidateFileCache(path.c_str());
+  if (path.endsWith(FPSTR(getPresetsFileName()))) {
+    presetsModifiedTime = toki.second();
+    invalidatePresetIndex();
+  }
+}
+
+// SPIFFSEditor (its handlers are final) wrapped so that files changed through /edit are not served stale from the file cache
+class FSEditorHandler : public AsyncWebHandler {
+  public:
+    explicit FSEditorHandler(SPIFFSEditor *editor) : _editor(editor) {}
+    ~FSEditorHandler() { delete _editor; }
+    bool canHandle(AsyncWebServerRequest *request) override { return _editor->canHandle(request); }
+    bool isRequestHandlerTrivial() override { return false; }
+    void handleRequest(AsyncWebServerRequest *request) override {
+      _editor->handleRequest(request);
+      // DELETE removes and PUT creates "path", POST (upload) is handled in handleUpload()
+      if ((request->method() == HTTP_DELETE || request->method() == HTTP_PUT) && request->hasParam(F("path"), true))
+        editorFileChanged(request->getParam(F("path"), true)->value());
+    }
+    void handleUpload(AsyncWebServerRequest *request, const String& filename, size_t index, uint8_t *data, size_t len, bool final) override {
+      _editor->handleUpload(request, filename, index, data, len, final);
+      if (final) editorFileChanged(filename);
+    }
+  private:
+    SPIFFSEditor *_editor;
+};
+#endif
+
 void createEditHandler(bool enable) {
   if (editHandler != nullptr) server.removeHandler(editHandler);
   if (enable) {
     #ifdef WLED_ENABLE_FS_EDITOR
       #ifdef ARDUINO_ARCH_ESP32
-      editHandler = &server.addHandler(new SPIFFSEditor(WLED_FS));//http_username,http_password));
+      editHandler = &server.addHandler(new FSEditorHandler(new SPIFFSEditor(WLED_FS)));//http_username,http_password));
       #else
-      editHandler = &server.addHandler(new SPIFFSEditor("","",WLED_FS));//http_username,http_password));
+      editHandler = &server.addHandler(new FSEditorHandler(new SPIFFSEditor("","",WLED_FS)));//http_username,http_password));
       #endif
     #else
       editHandler = &server.on(F("/edit"), HTTP_GET, [](AsyncWebServerRequest *request){